@@ -1,35 +1,101 @@
+/*
+ * dump_float: show the representation of floating-point values in
+ * hexadecimal.
+ *
+ * With no arguments, shows a few selected float, double and long
+ * double values; this is useful for updating floating_looks_like()
+ * in show_c_types.c.
+ *
+ * Otherwise it reads values from the named files (or "-" or no files
+ * for stdin) and writes one line per value: the bytes of its object
+ * representation in hexadecimal, in memory order, followed by its
+ * class (zero, subnormal, normal, infinite or nan).
+ *
+ *     dump_float [-t type] [-x] [-c] [file...]
+ *
+ *     -t type   float, double (the default) or long-double
+ *     -x        the input is text: whitespace-separated values in any
+ *               form accepted by strtod(), including hexadecimal
+ *               floating constants, "inf" and "nan".  Otherwise the
+ *               input is raw binary in this system's representation.
+ *     -c        don't show each value; just show the number of values
+ *               in each class
+ *
+ * Raw input is read and output written in large blocks, and the hex
+ * encoder works on 4 bytes at a time in a 64-bit integer without any
+ * per-value allocation, so dumping large arrays is limited mostly by
+ * I/O.  This needs C99 (<stdint.h>, fpclassify()).
+ */
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
 
-static char *hex_image(const void *base, size_t size) {
-    /*
-     * Note: This function returns a pointer to a malloc()ed buffer.
-     * The caller should free() the buffer.
-     */
-    static char *hex = "0123456789abcdef";
-    size_t i;
-    const unsigned char *data = base;
-    char *result = malloc(2 * size + 1);
-    int out_index = 0;
+#define INPUT_BUFFER_SIZE  (1024 * 1024)
+#define OUTPUT_BUFFER_SIZE (1024 * 1024)
+#define MAX_VALUE_SIZE     32               /* bytes; long double is at most 16 */
+#define MAX_LINE_SIZE      (2 * MAX_VALUE_SIZE + 16)
+#define TOKEN_SIZE         256
 
-    if (result == NULL) {
-        fprintf(stderr, "malloc failed\n");
-        exit(EXIT_FAILURE);
-    }
+/*
+ * Converts 4 bytes to 8 lowercase hexadecimal digits.  The nibbles are
+ * spread out to one per byte of a 64-bit integer, then converted to
+ * ASCII all at once: adding '0' to each, plus 'a' - '0' - 10 (39) to
+ * those that are 10 or more.  No byte can carry into the next.
+ */
+static void hex_encode_4(char *out, const unsigned char *in) {
+    uint64_t x = (uint64_t)in[0] << 24 | (uint64_t)in[1] << 16 |
+                 (uint64_t)in[2] << 8  | (uint64_t)in[3];
+    uint64_t letters;
+    int i;
 
-    for (i = 0; i < size; i ++) {
-        result[out_index++] = hex[data[i] / 16];
-        result[out_index++] = hex[data[i] % 16];
+    x = ((x & 0xffff0000U) << 16) | (x & 0x0000ffffU);
+    x = ((x & UINT64_C(0x0000ff000000ff00)) << 8) | (x & UINT64_C(0x000000ff000000ff));
+    x = ((x & UINT64_C(0x00f000f000f000f0)) << 4) | (x & UINT64_C(0x000f000f000f000f));
+    letters = ((x + UINT64_C(0x0606060606060606)) >> 4) & UINT64_C(0x0101010101010101);
+    x += UINT64_C(0x3030303030303030) + letters * 39;
+    for (i = 0; i < 8; i ++) {
+        out[i] = (char)(x >> (56 - 8 * i));
     }
+} /* hex_encode_4 */
+
+/*
+ * Writes the 2 * size hexadecimal digits for the object at base into
+ * out (which is not null-terminated) and returns a pointer just past
+ * them.
+ */
+static char *hex_encode(char *out, const void *base, size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    const unsigned char *data = base;
+    size_t i = 0;
 
-    result[out_index] = '\0';
+    for (; i + 4 <= size; i += 4) {
+        hex_encode_4(out, data + i);
+        out += 8;
+    }
+    for (; i < size; i ++) {
+        *out++ = hex[data[i] / 16];
+        *out++ = hex[data[i] % 16];
+    }
+    return out;
+} /* hex_encode */
 
+/*
+ * For the table of selected values.  result must have room for
+ * 2 * MAX_VALUE_SIZE + 1 characters.
+ */
+static char *hex_image(char *result, const void *base, size_t size) {
+    *hex_encode(result, base, size) = '\0';
     return result;
 } /* hex_image */
 
-#define SHOW(type, name, value) printf("%-12s %7s  %s\n", type, name, hex_image(&value, sizeof value))
+#define SHOW(type, name, value) \
+    printf("%-12s %7s  %s\n", type, name, hex_image(image, &value, sizeof value))
 
-int main(void) {
+static void show_selected_values(void) {
     const static float       f_one            =   1.0F;
     const static float       f_fraction       = 1.09375F;
     const static float       f_minus_sixteen  = -16.0F;
@@ -47,6 +113,8 @@ int main(void) {
     const static long double ld_one_million   = 1.0e6L;
 #endif
 
+    char image[2 * MAX_VALUE_SIZE + 1];
+
     SHOW("float", "1.0", f_one);
     SHOW("float", "1.09375", f_fraction);
     SHOW("float", "-16.0", f_minus_sixteen);
@@ -63,6 +131,274 @@ int main(void) {
     SHOW("long double", "-16.0", ld_minus_sixteen);
     SHOW("long double", "1.0e6", ld_one_million);
 #endif
-    
-    return 0;
+} /* show_selected_values */
+
+/*
+ * Classes, in the order of their counts.
+ */
+enum value_class { vc_zero, vc_subnormal, vc_normal, vc_infinite, vc_nan, vc_count };
+
+static const char *const class_names[vc_count] = {
+    "zero", "subnormal", "normal", "infinite", "nan"
+};
+
+static enum value_class classify(int fp_class) {
+    switch (fp_class) {
+        case FP_ZERO:      return vc_zero;
+        case FP_SUBNORMAL: return vc_subnormal;
+        case FP_INFINITE:  return vc_infinite;
+        case FP_NAN:       return vc_nan;
+        default:           return vc_normal;
+    }
 }
+
+enum value_type { vt_float, vt_double, vt_long_double };
+
+/*
+ * The current state of the dump: options, counts and the output buffer.
+ */
+struct dumper {
+    enum value_type type;
+    size_t size;
+    int counts_only;
+    unsigned long long counts[vc_count];
+    char *output;
+    size_t output_length;
+};
+
+static void flush_output(struct dumper *d) {
+    if (d->output_length > 0 && fwrite(d->output, 1, d->output_length, stdout) != d->output_length) {
+        perror("stdout");
+        exit(EXIT_FAILURE);
+    }
+    d->output_length = 0;
+}
+
+/*
+ * Classifies and (unless counting only) shows one value, whose object
+ * representation is at data.
+ */
+static void dump_value(struct dumper *d, const void *data) {
+    enum value_class c;
+
+    switch (d->type) {
+        case vt_float: {
+            float f;
+            memcpy(&f, data, sizeof f);
+            c = classify(fpclassify(f));
+            break;
+        }
+        case vt_double: {
+            double x;
+            memcpy(&x, data, sizeof x);
+            c = classify(fpclassify(x));
+            break;
+        }
+        default: {
+            long double x;
+            memcpy(&x, data, sizeof x);
+            c = classify(fpclassify(x));
+            break;
+        }
+    }
+    d->counts[c] ++;
+
+    if (! d->counts_only) {
+        char *out;
+        size_t name_length = strlen(class_names[c]);
+        if (d->output_length + MAX_LINE_SIZE > OUTPUT_BUFFER_SIZE) {
+            flush_output(d);
+        }
+        out = hex_encode(d->output + d->output_length, data, d->size);
+        *out++ = ' ';
+        memcpy(out, class_names[c], name_length);
+        out += name_length;
+        *out++ = '\n';
+        d->output_length = (size_t)(out - d->output);
+    }
+} /* dump_value */
+
+/*
+ * Reads raw values.  A partial value left at the end of one block is
+ * moved to the start of the buffer before the next read; a partial
+ * value at the end of the file is an error.
+ */
+static int dump_raw(struct dumper *d, FILE *in, const char *name, unsigned char *buffer) {
+    size_t length = 0;
+    size_t n;
+
+    while ((n = fread(buffer + length, 1, INPUT_BUFFER_SIZE - length, in)) > 0) {
+        size_t i;
+        length += n;
+        for (i = 0; i + d->size <= length; i += d->size) {
+            dump_value(d, buffer + i);
+        }
+        memmove(buffer, buffer + i, length - i);
+        length -= i;
+    }
+    if (ferror(in)) {
+        perror(name);
+        return 0;
+    }
+    if (length != 0) {
+        fprintf(stderr, "%s: %lu trailing bytes ignored\n", name, (unsigned long)length);
+        return 0;
+    }
+    return 1;
+} /* dump_raw */
+
+/*
+ * Reads text values, one whitespace-separated token at a time.
+ */
+static int dump_text(struct dumper *d, FILE *in, const char *name) {
+    char token[TOKEN_SIZE];
+    int ok = 1;
+    int c;
+
+    for (;;) {
+        size_t length = 0;
+        char *end;
+
+        while ((c = getc(in)) != EOF && isspace(c)) {
+            continue;
+        }
+        if (c == EOF) {
+            break;
+        }
+        while (c != EOF && ! isspace(c)) {
+            if (length < TOKEN_SIZE - 1) {
+                token[length++] = (char)c;
+            }
+            c = getc(in);
+        }
+        token[length] = '\0';
+
+        switch (d->type) {
+            case vt_float: {
+                const float f = strtof(token, &end);
+                if (*end == '\0') {
+                    dump_value(d, &f);
+                }
+                break;
+            }
+            case vt_double: {
+                const double x = strtod(token, &end);
+                if (*end == '\0') {
+                    dump_value(d, &x);
+                }
+                break;
+            }
+            default: {
+                const long double x = strtold(token, &end);
+                if (*end == '\0') {
+                    dump_value(d, &x);
+                }
+                break;
+            }
+        }
+        if (*end != '\0' || end == token) {
+            fprintf(stderr, "%s: invalid value \"%s\"\n", name, token);
+            ok = 0;
+        }
+    }
+    if (ferror(in)) {
+        perror(name);
+        return 0;
+    }
+    return ok;
+} /* dump_text */
+
+static void usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [-t float|double|long-double] [-x] [-c] [file...]\n", program_name);
+    fprintf(stderr, "With no arguments, shows selected values\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    static struct dumper d;
+    unsigned char *buffer = NULL;
+    int text = 0;
+    int ok = 1;
+    int i;
+
+    if (argc == 1) {
+        show_selected_values();
+        return 0;
+    }
+
+    d.type = vt_double;
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i ++) {
+        if (strcmp(argv[i], "--") == 0) {
+            i ++;
+            break;
+        }
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            i ++;
+            if (strcmp(argv[i], "float") == 0) {
+                d.type = vt_float;
+            }
+            else if (strcmp(argv[i], "double") == 0) {
+                d.type = vt_double;
+            }
+            else if (strcmp(argv[i], "long-double") == 0) {
+                d.type = vt_long_double;
+            }
+            else {
+                usage(argv[0]);
+            }
+        }
+        else if (strcmp(argv[i], "-x") == 0) {
+            text = 1;
+        }
+        else if (strcmp(argv[i], "-c") == 0) {
+            d.counts_only = 1;
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+    d.size = d.type == vt_float  ? sizeof (float) :
+             d.type == vt_double ? sizeof (double) : sizeof (long double);
+
+    d.output = malloc(OUTPUT_BUFFER_SIZE);
+    if (! text) {
+        buffer = malloc(INPUT_BUFFER_SIZE);
+    }
+    if (d.output == NULL || (! text && buffer == NULL)) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    do {
+        const char *const name = i < argc ? argv[i] : "-";
+        FILE *const in = strcmp(name, "-") == 0 ? stdin : fopen(name, text ? "r" : "rb");
+        if (in == NULL) {
+            perror(name);
+            ok = 0;
+            continue;
+        }
+        if (! (text ? dump_text(&d, in, name) : dump_raw(&d, in, name, buffer))) {
+            ok = 0;
+        }
+        if (in != stdin) {
+            fclose(in);
+        }
+    } while (++i < argc);
+
+    if (d.counts_only) {
+        int c;
+        for (c = 0; c < vc_count; c ++) {
+            printf("%s %llu\n", class_names[c], d.counts[c]);
+        }
+    }
+    else {
+        flush_output(&d);
+    }
+    if (fflush(stdout) != 0) {
+        perror("stdout");
+        ok = 0;
+    }
+    free(d.output);
+    free(buffer);
+    return ok ? 0 : EXIT_FAILURE;
+} /* main */
@@ -0,0 +1,815 @@
+/*
+ * Copyright (C) 2026 Keith Thompson
+ */
+
+/*
+ * This file is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * results_daemon loads every "*.ini" file in a results directory
+ * (by default "results") into memory and answers queries about them
+ * over a Unix domain socket, so that build scripts don't each have to
+ * find and parse the files themselves.
+ *
+ * Usage:
+ *     results_daemon [-d directory] [-s socket-path]
+ *
+ * The target name for a file is its name without the ".ini" suffix,
+ * for example "aarch64-unknown-linux-gnu".  Spaces in section names
+ * (as written by older versions of show_c_types) are replaced by
+ * hyphens, so "[long double]" is queried as "long-double".
+ *
+ * The protocol is line-oriented.  Each request is one line; fields
+ * are separated by spaces.  Each response starts with a line beginning
+ * with "OK" or "ERR".  Requests can be pipelined.
+ *
+ *     GET <target> <section> <key>
+ *         OK <value>
+ *     SECTION <target> <section>
+ *         OK <n>, followed by n lines of the form "<key> = <value>"
+ *     TARGETS
+ *         OK <n>, followed by n target names
+ *     SECTIONS <target>
+ *         OK <n>, followed by n section names
+ *     RELOAD
+ *         OK <number of targets>
+ *
+ * For example:
+ *     $ echo 'GET aarch64-unknown-linux-gnu long-double size' | nc -U results.sock
+ *     OK 128
+ *
+ * The directory is checked for new, changed or removed files once a
+ * second, even while queries keep arriving, and reloaded if anything
+ * changed (or on SIGHUP).  If a reload fails, the previous contents are
+ * kept.
+ *
+ * The daemon is a single thread using poll(); lookups are binary
+ * searches over sorted arrays, so each query costs a few microseconds.
+ *
+ * Author: Keith Thompson <Keith.S.Thompson@gmail.com>
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define DEFAULT_DIRECTORY "results"
+#define DEFAULT_SOCKET "results.sock"
+#define MAX_CLIENTS 1024
+#define MAX_REQUEST 1024
+#define RESCAN_MILLISECONDS 1000
+
+/*
+ * The nanoseconds of the file times: st_mtim and st_ctim in
+ * POSIX.1-2008, st_mtimespec and st_ctimespec on macOS.
+ */
+#if defined(__APPLE__)
+#    define MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#    define CTIME_NSEC(st) ((st).st_ctimespec.tv_nsec)
+#else
+#    define MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#    define CTIME_NSEC(st) ((st).st_ctim.tv_nsec)
+#endif
+
+/*
+ * The index.  Every line "key = value" in a file becomes an entry.
+ * entries[] is in file order, so a section is a contiguous run of
+ * entries; lookup[] and sections[] are sorted for binary search.
+ * All the strings point into the file contents in buffers[].
+ */
+
+struct entry {
+    const char *target;
+    const char *section;
+    const char *key;
+    const char *value;
+};
+
+struct section {
+    const char *target;
+    const char *name;
+    size_t first;   /* index into entries */
+    size_t count;
+};
+
+struct index {
+    char **buffers;
+    size_t buffer_count;
+    const char **targets;
+    size_t target_count;
+    struct entry *entries;
+    size_t entry_count;
+    struct entry **lookup;
+    struct section *sections;
+    size_t section_count;
+};
+
+static struct index *current_index = NULL;
+static const char *directory = DEFAULT_DIRECTORY;
+static const char *socket_path = DEFAULT_SOCKET;
+static unsigned long directory_signature = 0;
+static volatile sig_atomic_t reload_requested = 0;
+static volatile sig_atomic_t stop_requested = 0;
+
+static void *xrealloc(void *ptr, size_t size) {
+    void *const result = realloc(ptr, size);
+    if (result == NULL && size != 0) {
+        fprintf(stderr, "realloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+static void free_index(struct index *ix) {
+    size_t i;
+    if (ix == NULL) {
+        return;
+    }
+    for (i = 0; i < ix->buffer_count; i ++) {
+        free(ix->buffers[i]);
+    }
+    free(ix->buffers);
+    free(ix->targets);
+    free(ix->entries);
+    free(ix->lookup);
+    free(ix->sections);
+    free(ix);
+}
+
+static int compare_strings(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+static int compare_entries(const void *a, const void *b) {
+    const struct entry *const x = *(const struct entry *const *)a;
+    const struct entry *const y = *(const struct entry *const *)b;
+    int result = strcmp(x->target, y->target);
+    if (result == 0) {
+        result = strcmp(x->section, y->section);
+    }
+    if (result == 0) {
+        result = strcmp(x->key, y->key);
+    }
+    return result;
+}
+
+static int compare_sections(const void *a, const void *b) {
+    const struct section *const x = a;
+    const struct section *const y = b;
+    const int result = strcmp(x->target, y->target);
+    return result != 0 ? result : strcmp(x->name, y->name);
+}
+
+static char *trim(char *s) {
+    char *end;
+    while (*s == ' ' || *s == '\t') {
+        s ++;
+    }
+    end = s + strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+        end --;
+    }
+    *end = '\0';
+    return s;
+}
+
+/*
+ * Reads the whole file into a malloc()ed, null-terminated buffer.
+ * Returns NULL on failure.
+ */
+static char *read_file(const char *path) {
+    FILE *const f = fopen(path, "rb");
+    char *buffer = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+
+    if (f == NULL) {
+        return NULL;
+    }
+    for (;;) {
+        size_t got;
+        if (capacity - size < 4096) {
+            capacity = capacity * 2 + 4096;
+            buffer = xrealloc(buffer, capacity + 1);
+        }
+        got = fread(buffer + size, 1, capacity - size, f);
+        size += got;
+        if (got == 0) {
+            break;
+        }
+    }
+    if (ferror(f)) {
+        free(buffer);
+        fclose(f);
+        return NULL;
+    }
+    fclose(f);
+    buffer[size] = '\0';
+    return buffer;
+}
+
+/*
+ * Adds the contents of one file to the index, modifying the buffer
+ * in place.
+ */
+static void parse_ini(struct index *ix, const char *target, char *buffer, size_t *entry_capacity) {
+    const char *section = "";
+    char *line = buffer;
+
+    while (line != NULL && *line != '\0') {
+        char *next = strchr(line, '\n');
+        char *text;
+        if (next != NULL) {
+            *next++ = '\0';
+        }
+        text = trim(line);
+        if (text[0] == '[') {
+            char *const close = strrchr(text, ']');
+            if (close != NULL) {
+                char *p;
+                *close = '\0';
+                section = text + 1;
+                for (p = text + 1; *p != '\0'; p ++) {
+                    if (*p == ' ') {
+                        *p = '-';
+                    }
+                }
+            }
+        }
+        else if (text[0] != '\0' && text[0] != ';' && text[0] != '#') {
+            char *const equals = strchr(text, '=');
+            if (equals != NULL) {
+                struct entry *e;
+                *equals = '\0';
+                if (ix->entry_count == *entry_capacity) {
+                    *entry_capacity = *entry_capacity * 2 + 256;
+                    ix->entries = xrealloc(ix->entries, *entry_capacity * sizeof *ix->entries);
+                }
+                e = &ix->entries[ix->entry_count++];
+                e->target = target;
+                e->section = section;
+                e->key = trim(text);
+                e->value = trim(equals + 1);
+            }
+        }
+        line = next;
+    }
+}
+
+static int is_ini_file(const char *name) {
+    const size_t len = strlen(name);
+    return len > 4 && strcmp(name + len - 4, ".ini") == 0 && name[0] != '.';
+}
+
+/*
+ * Returns a value that changes whenever a "*.ini" file in the
+ * directory is added, removed, renamed or modified.
+ */
+static unsigned long scan_directory(void) {
+    DIR *const dir = opendir(directory);
+    unsigned long signature = 5381;
+    struct dirent *d;
+
+    if (dir == NULL) {
+        return 0;
+    }
+    while ((d = readdir(dir)) != NULL) {
+        char path[4096];
+        struct stat st;
+        const char *p;
+        if (! is_ini_file(d->d_name)) {
+            continue;
+        }
+        sprintf(path, "%.2000s/%.2000s", directory, d->d_name);
+        if (stat(path, &st) != 0) {
+            continue;
+        }
+        /*
+         * Order-independent combination of the name, inode, size and
+         * times.  The nanoseconds and the inode catch a rewrite of the
+         * same size within the same second (an editor or "mv" replaces
+         * the inode; an in-place write changes the ctime).
+         */
+        {
+            unsigned long h = 5381;
+            for (p = d->d_name; *p != '\0'; p ++) {
+                h = h * 33 + (unsigned char)*p;
+            }
+            h ^= (unsigned long)st.st_ino * 97UL;
+            h ^= (unsigned long)st.st_size * 2654435761UL;
+            h ^= ((unsigned long)st.st_mtime * 1000000000UL + (unsigned long)MTIME_NSEC(st)) * 40503UL;
+            h ^= ((unsigned long)st.st_ctime * 1000000000UL + (unsigned long)CTIME_NSEC(st)) * 69069UL;
+            signature += h;
+        }
+    }
+    closedir(dir);
+    return signature;
+}
+
+/*
+ * Loads every "*.ini" file in the directory.  Returns NULL if the
+ * directory can't be read.
+ */
+static struct index *load_index(void) {
+    DIR *const dir = opendir(directory);
+    struct index *ix;
+    struct dirent *d;
+    size_t entry_capacity = 0;
+    size_t i;
+
+    if (dir == NULL) {
+        fprintf(stderr, "results_daemon: %s: %s\n", directory, strerror(errno));
+        return NULL;
+    }
+    ix = calloc(1, sizeof *ix);
+    if (ix == NULL) {
+        fprintf(stderr, "calloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    while ((d = readdir(dir)) != NULL) {
+        char path[4096];
+        char *buffer;
+        char *target;
+        const size_t name_len = strlen(d->d_name);
+
+        if (! is_ini_file(d->d_name)) {
+            continue;
+        }
+        sprintf(path, "%.2000s/%.2000s", directory, d->d_name);
+        buffer = read_file(path);
+        if (buffer == NULL) {
+            fprintf(stderr, "results_daemon: %s: %s\n", path, strerror(errno));
+            continue;
+        }
+        target = xrealloc(NULL, name_len - 4 + 1);
+        memcpy(target, d->d_name, name_len - 4);
+        target[name_len - 4] = '\0';
+
+        ix->buffers = xrealloc(ix->buffers, (ix->buffer_count + 2) * sizeof *ix->buffers);
+        ix->buffers[ix->buffer_count++] = buffer;
+        ix->buffers[ix->buffer_count++] = target;
+        ix->targets = xrealloc(ix->targets, (ix->target_count + 1) * sizeof *ix->targets);
+        ix->targets[ix->target_count++] = target;
+        parse_ini(ix, target, buffer, &entry_capacity);
+    }
+    closedir(dir);
+
+    qsort(ix->targets, ix->target_count, sizeof *ix->targets, compare_strings);
+
+    ix->lookup = xrealloc(NULL, (ix->entry_count + 1) * sizeof *ix->lookup);
+    for (i = 0; i < ix->entry_count; i ++) {
+        ix->lookup[i] = &ix->entries[i];
+    }
+    qsort(ix->lookup, ix->entry_count, sizeof *ix->lookup, compare_entries);
+
+    for (i = 0; i < ix->entry_count; i ++) {
+        const struct entry *const e = &ix->entries[i];
+        struct section *s;
+        if (ix->section_count > 0) {
+            s = &ix->sections[ix->section_count - 1];
+            if (s->target == e->target && s->name == e->section) {
+                s->count ++;
+                continue;
+            }
+        }
+        ix->sections = xrealloc(ix->sections, (ix->section_count + 1) * sizeof *ix->sections);
+        s = &ix->sections[ix->section_count++];
+        s->target = e->target;
+        s->name = e->section;
+        s->first = i;
+        s->count = 1;
+    }
+    qsort(ix->sections, ix->section_count, sizeof *ix->sections, compare_sections);
+
+    return ix;
+}
+
+/*
+ * Milliseconds on a clock that isn't affected by changes to the time
+ * of day, for scheduling the rescans.
+ */
+static long long monotonic_milliseconds(void) {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void reload(void) {
+    const unsigned long signature = scan_directory();
+    struct index *const ix = load_index();
+    if (ix != NULL) {
+        free_index(current_index);
+        current_index = ix;
+        directory_signature = signature;
+        fprintf(stderr, "results_daemon: loaded %lu targets, %lu entries from %s\n",
+                (unsigned long)ix->target_count, (unsigned long)ix->entry_count, directory);
+    }
+}
+
+static const struct entry *find_entry(const char *target, const char *section, const char *key) {
+    struct entry probe;
+    const struct entry *const probe_ptr = &probe;
+    struct entry **found;
+    probe.target = target;
+    probe.section = section;
+    probe.key = key;
+    found = bsearch(&probe_ptr, current_index->lookup, current_index->entry_count,
+                    sizeof *current_index->lookup, compare_entries);
+    return found == NULL ? NULL : *found;
+}
+
+static const struct section *find_section(const char *target, const char *name) {
+    struct section probe;
+    probe.target = target;
+    probe.name = name;
+    return bsearch(&probe, current_index->sections, current_index->section_count,
+                   sizeof *current_index->sections, compare_sections);
+}
+
+/*
+ * Clients.  Each has an input buffer holding at most one partial
+ * request and an output buffer that grows as needed.
+ */
+
+struct client {
+    int fd;
+    char in[MAX_REQUEST];
+    size_t in_len;
+    char *out;
+    size_t out_len;
+    size_t out_capacity;
+    int closing;
+};
+
+static struct client clients[MAX_CLIENTS];
+static size_t client_count = 0;
+
+static void append(struct client *c, const char *s, size_t len) {
+    if (c->out_len + len > c->out_capacity) {
+        c->out_capacity = (c->out_len + len) * 2;
+        c->out = xrealloc(c->out, c->out_capacity);
+    }
+    memcpy(c->out + c->out_len, s, len);
+    c->out_len += len;
+}
+
+static void append_str(struct client *c, const char *s) {
+    append(c, s, strlen(s));
+}
+
+static void append_count(struct client *c, size_t n) {
+    char buf[40];
+    sprintf(buf, "OK %lu\n", (unsigned long)n);
+    append_str(c, buf);
+}
+
+static void handle_request(struct client *c, char *line) {
+    char *fields[5];
+    int n = 0;
+    char *p = line;
+
+    while (n < 5) {
+        while (*p == ' ' || *p == '\t' || *p == '\r') {
+            *p++ = '\0';
+        }
+        if (*p == '\0') {
+            break;
+        }
+        fields[n++] = p;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r') {
+            p ++;
+        }
+    }
+
+    if (n == 0) {
+        append_str(c, "ERR empty request\n");
+    }
+    else if (strcmp(fields[0], "GET") == 0 && n == 4) {
+        const struct entry *const e = find_entry(fields[1], fields[2], fields[3]);
+        if (e == NULL) {
+            append_str(c, "ERR not found\n");
+        }
+        else {
+            append_str(c, "OK ");
+            append_str(c, e->value);
+            append_str(c, "\n");
+        }
+    }
+    else if (strcmp(fields[0], "SECTION") == 0 && n == 3) {
+        const struct section *const s = find_section(fields[1], fields[2]);
+        if (s == NULL) {
+            append_str(c, "ERR not found\n");
+        }
+        else {
+            size_t i;
+            append_count(c, s->count);
+            for (i = s->first; i < s->first + s->count; i ++) {
+                append_str(c, current_index->entries[i].key);
+                append_str(c, " = ");
+                append_str(c, current_index->entries[i].value);
+                append_str(c, "\n");
+            }
+        }
+    }
+    else if (strcmp(fields[0], "TARGETS") == 0 && n == 1) {
+        size_t i;
+        append_count(c, current_index->target_count);
+        for (i = 0; i < current_index->target_count; i ++) {
+            append_str(c, current_index->targets[i]);
+            append_str(c, "\n");
+        }
+    }
+    else if (strcmp(fields[0], "SECTIONS") == 0 && n == 2) {
+        size_t first = current_index->section_count;
+        size_t i;
+        for (i = 0; i < current_index->section_count; i ++) {
+            if (strcmp(current_index->sections[i].target, fields[1]) == 0) {
+                if (first == current_index->section_count) {
+                    first = i;
+                }
+            }
+            else if (first != current_index->section_count) {
+                break;
+            }
+        }
+        if (first == current_index->section_count) {
+            append_str(c, "ERR not found\n");
+        }
+        else {
+            /* list sections in file order */
+            size_t count = i - first;
+            size_t j;
+            const struct section **ordered = xrealloc(NULL, count * sizeof *ordered);
+            for (j = 0; j < count; j ++) {
+                ordered[j] = &current_index->sections[first + j];
+            }
+            for (j = 1; j < count; j ++) {
+                const struct section *const s = ordered[j];
+                size_t k = j;
+                while (k > 0 && ordered[k - 1]->first > s->first) {
+                    ordered[k] = ordered[k - 1];
+                    k --;
+                }
+                ordered[k] = s;
+            }
+            append_count(c, count);
+            for (j = 0; j < count; j ++) {
+                append_str(c, ordered[j]->name);
+                append_str(c, "\n");
+            }
+            free(ordered);
+        }
+    }
+    else if (strcmp(fields[0], "RELOAD") == 0 && n == 1) {
+        reload();
+        append_count(c, current_index->target_count);
+    }
+    else {
+        append_str(c, "ERR bad request\n");
+    }
+}
+
+/*
+ * Handles every complete line in the client's input buffer.
+ */
+static void process_input(struct client *c) {
+    size_t start = 0;
+    size_t i;
+    for (i = 0; i < c->in_len; i ++) {
+        if (c->in[i] == '\n') {
+            c->in[i] = '\0';
+            handle_request(c, c->in + start);
+            start = i + 1;
+        }
+    }
+    if (start == 0 && c->in_len == sizeof c->in) {
+        append_str(c, "ERR request too long\n");
+        c->closing = 1;
+        c->in_len = 0;
+        return;
+    }
+    memmove(c->in, c->in + start, c->in_len - start);
+    c->in_len -= start;
+}
+
+static void remove_client(size_t i) {
+    close(clients[i].fd);
+    free(clients[i].out);
+    clients[i] = clients[--client_count];
+}
+
+static int set_nonblocking(int fd) {
+    const int flags = fcntl(fd, F_GETFL);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static int open_socket(void) {
+    struct sockaddr_un addr;
+    int fd;
+
+    if (strlen(socket_path) >= sizeof addr.sun_path) {
+        fprintf(stderr, "results_daemon: socket path too long\n");
+        exit(EXIT_FAILURE);
+    }
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        exit(EXIT_FAILURE);
+    }
+    memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof addr) != 0) {
+        perror(socket_path);
+        exit(EXIT_FAILURE);
+    }
+    if (listen(fd, SOMAXCONN) != 0 || set_nonblocking(fd) != 0) {
+        perror("listen");
+        exit(EXIT_FAILURE);
+    }
+    return fd;
+}
+
+static void on_sighup(int sig) {
+    (void)sig;
+    reload_requested = 1;
+}
+
+static void on_stop(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [-d directory] [-s socket-path]\n", program_name);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    static struct pollfd fds[MAX_CLIENTS + 1];
+    struct sigaction sa;
+    long long last_scan;
+    int listen_fd;
+    int i;
+
+    for (i = 1; i < argc; i ++) {
+        if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            directory = argv[++i];
+        }
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+
+    memset(&sa, 0, sizeof sa);
+    sigemptyset(&sa.sa_mask);
+    sa.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &sa, NULL);
+    sa.sa_handler = on_sighup;
+    sigaction(SIGHUP, &sa, NULL);
+    sa.sa_handler = on_stop;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    reload();
+    if (current_index == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    listen_fd = open_socket();
+    last_scan = monotonic_milliseconds();
+
+    while (! stop_requested) {
+        size_t nfds = 0;
+        size_t c;
+        long long now;
+        long long wait;
+        int ready;
+
+        fds[nfds].fd = listen_fd;
+        fds[nfds].events = client_count < MAX_CLIENTS ? POLLIN : 0;
+        nfds ++;
+        for (c = 0; c < client_count; c ++) {
+            fds[nfds].fd = clients[c].fd;
+            fds[nfds].events = clients[c].out_len > 0 ? POLLOUT : POLLIN;
+            nfds ++;
+        }
+
+        /*
+         * Rescan every RESCAN_MILLISECONDS however busy the clients keep
+         * us, not just when poll() times out.
+         */
+        wait = RESCAN_MILLISECONDS - (monotonic_milliseconds() - last_scan);
+        ready = poll(fds, nfds, wait < 0 ? 0 : (int)wait);
+        if (ready < 0 && errno != EINTR) {
+            perror("poll");
+            break;
+        }
+
+        now = monotonic_milliseconds();
+        if (reload_requested || now - last_scan >= RESCAN_MILLISECONDS) {
+            if (reload_requested || scan_directory() != directory_signature) {
+                reload();
+            }
+            reload_requested = 0;
+            last_scan = now;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+
+        /*
+         * Walk the clients backwards so that remove_client(), which moves
+         * the last client into the freed slot, doesn't skip anyone.
+         */
+        for (c = client_count; c-- > 0; ) {
+            struct client *const cl = &clients[c];
+            const short revents = fds[c + 1].revents;
+            if (revents & (POLLERR | POLLNVAL)) {
+                remove_client(c);
+                continue;
+            }
+            if (revents & POLLOUT) {
+                const ssize_t written = write(cl->fd, cl->out, cl->out_len);
+                if (written < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    remove_client(c);
+                    continue;
+                }
+                if (written > 0) {
+                    memmove(cl->out, cl->out + written, cl->out_len - (size_t)written);
+                    cl->out_len -= (size_t)written;
+                }
+                if (cl->out_len == 0 && cl->closing) {
+                    remove_client(c);
+                    continue;
+                }
+            }
+            else if (revents & (POLLIN | POLLHUP)) {
+                const ssize_t got = read(cl->fd, cl->in + cl->in_len, sizeof cl->in - cl->in_len);
+                if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    remove_client(c);
+                    continue;
+                }
+                if (got > 0) {
+                    cl->in_len += (size_t)got;
+                    process_input(cl);
+                }
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            for (;;) {
+                const int fd = accept(listen_fd, NULL, NULL);
+                if (fd < 0) {
+                    break;
+                }
+                if (client_count == MAX_CLIENTS || set_nonblocking(fd) != 0) {
+                    close(fd);
+                    break;
+                }
+                memset(&clients[client_count], 0, sizeof clients[client_count]);
+                clients[client_count].fd = fd;
+                client_count ++;
+            }
+        }
+    }
+
+    unlink(socket_path);
+    while (client_count > 0) {
+        remove_client(client_count - 1);
+    }
+    free_index(current_index);
+    exit(EXIT_SUCCESS);
+} /* main */
@@ -30,6 +30,16 @@
 #error "Please use a C compiler not a C++ compiler"
 #endif
 
+#ifdef ENABLE_BENCHMARKS
+/*
+ * The measurement sections use POSIX and system-specific interfaces
+ * where they're available.  This has to be requested before any
+ * system header is included.  It's not needed (and not defined) for
+ * the type probes.
+ */
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
@@ -38,7 +48,7 @@
 #include <float.h>
 #include <time.h>
 
-#define SHOW_C_TYPES_VERSION "2023-12-03"
+#define SHOW_C_TYPES_VERSION "2026-10-19"
 /*
  * The version is the date in YYYY-MM-DD format.
  * If you modify this program, please update this definition.
@@ -54,6 +64,11 @@
  * not support signed char or long double.
  *
  * See the header comment in Makefile for details.
+ *
+ * If ENABLE_BENCHMARKS is defined, the program also prints a number of
+ * "measurement" sections.  These time operations on this system rather
+ * than just describing types, so their contents vary from run to run.
+ * They're intended to be compiled with optimization ("make bench").
  */
 
 /*
@@ -123,10 +138,245 @@
 #    undef GENERIC_SELECTION_SUPPORTED
 #endif
 
+#if defined(DISABLE_COMPLEX)
+#    undef COMPLEX_EXISTS
+#elif defined(ENABLE_COMPLEX)
+#    define COMPLEX_EXISTS
+#elif __STDC_VERSION__ >= 199901L && !defined(__STDC_NO_COMPLEX__)
+#    define COMPLEX_EXISTS
+#else
+#    undef COMPLEX_EXISTS
+#endif
+
+#if defined(DISABLE_ENUM_UNDERLYING_TYPE)
+#    undef ENUM_UNDERLYING_TYPE_SUPPORTED
+#elif defined(ENABLE_ENUM_UNDERLYING_TYPE)
+#    define ENUM_UNDERLYING_TYPE_SUPPORTED
+#elif __STDC_VERSION__ >= 202311L
+#    define ENUM_UNDERLYING_TYPE_SUPPORTED
+#else
+#    undef ENUM_UNDERLYING_TYPE_SUPPORTED
+#endif
+
+/*
+ * __int128 and unsigned __int128 are gcc and clang extensions on most
+ * 64-bit targets.  C23's _BitInt(N) exists if <limits.h> defines
+ * BITINT_MAXWIDTH.
+ */
+#if defined(DISABLE_INT128)
+#    undef INT128_EXISTS
+#elif defined(ENABLE_INT128) || defined(__SIZEOF_INT128__)
+#    define INT128_EXISTS
+#else
+#    undef INT128_EXISTS
+#endif
+
+#if defined(DISABLE_BITINT) || !defined(BITINT_MAXWIDTH)
+#    undef BITINT_EXISTS
+#else
+#    define BITINT_EXISTS
+#endif
+
+/*
+ * _Float16, the other _FloatN and _FloatNx types, and __bf16 (bfloat16)
+ * are detected by the predefined macros that gcc and clang define for
+ * them, such as __FLT16_MANT_DIG__.
+ */
+#if defined(DISABLE_FLOAT16) || !defined(__FLT16_MANT_DIG__)
+#    undef FLOAT16_EXISTS
+#else
+#    define FLOAT16_EXISTS
+#endif
+
+#if defined(DISABLE_BF16) || !defined(__BFLT16_MANT_DIG__)
+#    undef BF16_EXISTS
+#else
+#    define BF16_EXISTS
+#endif
+
+#if defined(DISABLE_FLOATN)
+#    undef FLOATN_EXISTS
+#else
+#    define FLOATN_EXISTS
+#endif
+
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_UCHAR_H)
+#    undef UCHAR_H_EXISTS
+#elif defined(ENABLE_UCHAR_H)
+#    define UCHAR_H_EXISTS
+#elif __STDC_VERSION__ >= 201112L
+#    define UCHAR_H_EXISTS
+#else
+#    undef UCHAR_H_EXISTS
+#endif
+
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_POSIX)
+#    undef POSIX_EXISTS
+#elif defined(ENABLE_POSIX)
+#    define POSIX_EXISTS
+#elif defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#    define POSIX_EXISTS
+#else
+#    undef POSIX_EXISTS
+#endif
+
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_THREADS_H)
+#    undef THREADS_H_EXISTS
+#elif defined(ENABLE_THREADS_H)
+#    define THREADS_H_EXISTS
+#elif __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#    define THREADS_H_EXISTS
+#else
+#    undef THREADS_H_EXISTS
+#endif
+
+#if defined(ENABLE_BENCHMARKS) && !defined(STDINT_H_EXISTS)
+#error "ENABLE_BENCHMARKS requires <stdint.h>"
+#endif
+
 #ifdef STDINT_H_EXISTS
 #include <stdint.h>
 #endif
 
+#ifdef ENABLE_BENCHMARKS
+#include <inttypes.h>
+#include <math.h>
+#include <locale.h>
+#include <wchar.h>
+#endif
+
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_STDCKDINT_H)
+#    undef STDCKDINT_H_EXISTS
+#elif defined(ENABLE_STDCKDINT_H)
+#    define STDCKDINT_H_EXISTS
+#elif __STDC_VERSION__ >= 202311L
+#    define STDCKDINT_H_EXISTS
+#else
+#    undef STDCKDINT_H_EXISTS
+#endif
+
+/*
+ * gcc 5 and later and clang have __builtin_add_overflow() and friends.
+ */
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_OVERFLOW_BUILTINS)
+#    undef OVERFLOW_BUILTINS_EXIST
+#elif defined(ENABLE_OVERFLOW_BUILTINS)
+#    define OVERFLOW_BUILTINS_EXIST
+#elif defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+#    define OVERFLOW_BUILTINS_EXIST
+#else
+#    undef OVERFLOW_BUILTINS_EXIST
+#endif
+
+/*
+ * __builtin_dwarf_cfa() is a gcc extension.  Other compilers that
+ * define __GNUC__ don't all have it, or don't give it the same meaning.
+ */
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_DWARF_CFA)
+#    undef DWARF_CFA_EXISTS
+#elif defined(ENABLE_DWARF_CFA)
+#    define DWARF_CFA_EXISTS
+#elif defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER)
+#    define DWARF_CFA_EXISTS
+#else
+#    undef DWARF_CFA_EXISTS
+#endif
+
+#ifdef UCHAR_H_EXISTS
+#include <uchar.h>
+#endif
+
+#ifdef STDCKDINT_H_EXISTS
+#include <stdckdint.h>
+#endif
+
+#ifdef POSIX_EXISTS
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+#if defined(POSIX_EXISTS) && defined(_POSIX_TIMERS) && _POSIX_TIMERS > 0
+#    define CLOCK_GETTIME_EXISTS
+#else
+#    undef CLOCK_GETTIME_EXISTS
+#endif
+
+/*
+ * --cpu=n pins the process to one CPU; only Linux has a usable
+ * interface for this.
+ */
+#if defined(POSIX_EXISTS) && defined(__linux__)
+#include <sched.h>
+#    define SCHED_SETAFFINITY_EXISTS
+#else
+#    undef SCHED_SETAFFINITY_EXISTS
+#endif
+
+/*
+ * A cycle counter, read with inline assembly.  On x86 this is the
+ * time stamp counter, which ticks at a constant reference rate rather
+ * than the current core clock; on AArch64 it's the virtual counter,
+ * which usually ticks much more slowly than the core.  Either way it
+ * has much finer granularity than most clocks.
+ */
+#if !defined(ENABLE_BENCHMARKS) || defined(DISABLE_CYCLE_COUNTER)
+#    undef CYCLE_COUNTER_EXISTS
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#    define CYCLE_COUNTER_EXISTS
+#    define CYCLE_COUNTER_NAME "rdtsc"
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#    define CYCLE_COUNTER_EXISTS
+#    define CYCLE_COUNTER_NAME "cntvct_el0"
+#else
+#    undef CYCLE_COUNTER_EXISTS
+#endif
+
+/*
+ * Hardware performance counters (--counters), via Linux
+ * perf_event_open().
+ */
+#if defined(POSIX_EXISTS) && defined(__linux__) && !defined(DISABLE_PERF_EVENT)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#    define PERF_EVENT_EXISTS
+#else
+#    undef PERF_EVENT_EXISTS
+#endif
+
+/*
+ * Measurement sections can run in parallel (--jobs=n) using either
+ * C11 threads or POSIX threads.
+ */
+#if defined(THREADS_H_EXISTS)
+#include <threads.h>
+#    define PARALLEL_PROBES_SUPPORTED
+typedef thrd_t probe_thread;
+typedef mtx_t probe_mutex;
+#    define PROBE_THREAD_FUNCTION(name, arg) static int name(void *arg)
+#    define PROBE_THREAD_RETURN return 0
+#    define probe_thread_create(t, f, arg) (thrd_create((t), (f), (arg)) == thrd_success)
+#    define probe_thread_join(t) ((void)thrd_join((t), NULL))
+#    define probe_mutex_init(m) ((void)mtx_init((m), mtx_plain))
+#    define probe_mutex_lock(m) ((void)mtx_lock(m))
+#    define probe_mutex_unlock(m) ((void)mtx_unlock(m))
+#    define probe_mutex_destroy(m) mtx_destroy(m)
+#elif defined(POSIX_EXISTS)
+#include <pthread.h>
+#    define PARALLEL_PROBES_SUPPORTED
+typedef pthread_t probe_thread;
+typedef pthread_mutex_t probe_mutex;
+#    define PROBE_THREAD_FUNCTION(name, arg) static void *name(void *arg)
+#    define PROBE_THREAD_RETURN return NULL
+#    define probe_thread_create(t, f, arg) (pthread_create((t), NULL, (f), (arg)) == 0)
+#    define probe_thread_join(t) ((void)pthread_join((t), NULL))
+#    define probe_mutex_init(m) ((void)pthread_mutex_init((m), NULL))
+#    define probe_mutex_lock(m) ((void)pthread_mutex_lock(m))
+#    define probe_mutex_unlock(m) ((void)pthread_mutex_unlock(m))
+#    define probe_mutex_destroy(m) ((void)pthread_mutex_destroy(m))
+#endif
+
 #if defined(STDINT_H_EXISTS)
 typedef intmax_t longest_signed;
 typedef uintmax_t longest_unsigned;
@@ -138,6 +388,60 @@ typedef long longest_signed;
 typedef unsigned long longest_unsigned;
 #endif
 
+/*
+ * Extended integer types.  These can be wider than longest_signed and
+ * longest_unsigned, so their ranges are formatted by functions of
+ * their own.
+ */
+#ifdef INT128_EXISTS
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+#endif
+#if defined(BITINT_EXISTS) && BITINT_MAXWIDTH >= 128
+#    define BITINT_128_EXISTS
+typedef _BitInt(128) bitint_128;
+typedef unsigned _BitInt(128) ubitint_128;
+#endif
+#if defined(BITINT_EXISTS) && BITINT_MAXWIDTH >= 256
+#    define BITINT_256_EXISTS
+typedef _BitInt(256) bitint_256;
+typedef unsigned _BitInt(256) ubitint_256;
+#endif
+
+/*
+ * Extended floating types.
+ */
+#ifdef FLOAT16_EXISTS
+__extension__ typedef _Float16 float_16;
+#endif
+#ifdef BF16_EXISTS
+__extension__ typedef __bf16 bfloat_16;
+#endif
+#ifdef FLOATN_EXISTS
+#    ifdef __FLT32_MANT_DIG__
+__extension__ typedef _Float32 float_32;
+#    endif
+#    ifdef __FLT64_MANT_DIG__
+__extension__ typedef _Float64 float_64;
+#    endif
+#    ifdef __FLT128_MANT_DIG__
+__extension__ typedef _Float128 float_128;
+#    endif
+#    ifdef __FLT32X_MANT_DIG__
+__extension__ typedef _Float32x float_32x;
+#    endif
+#    ifdef __FLT64X_MANT_DIG__
+__extension__ typedef _Float64x float_64x;
+#    endif
+#    ifdef __FLT128X_MANT_DIG__
+__extension__ typedef _Float128x float_128x;
+#    endif
+#endif
+
+#ifdef COMPLEX_EXISTS
+#include <complex.h>
+#endif
+
 #ifdef STDBOOL_H_EXISTS
 #include <stdbool.h>
 #else
@@ -155,6 +459,19 @@ typedef enum { false, true } bool; /* for internal use only; we don't show
 
 #define MAX_SIZE 128
 
+/*
+ * Sizes of the caller-supplied buffers for signed_image(),
+ * unsigned_image() and space_to_hyphen().
+ */
+#define IMAGE_SIZE (CHAR_BIT * sizeof (longest_unsigned))
+#define NAME_SIZE 100
+
+/*
+ * Size of the buffers for measurement keys, which join one or two
+ * names (see space_to_hyphen()) with short suffixes.
+ */
+#define KEY_SIZE (2 * NAME_SIZE + 100)
+
 static int comment_index = 0;
 
 static const char *longest_unsigned_format;
@@ -180,6 +497,17 @@ static const long double ld_one_million   = 1.0e6L;
 enum small_enum { se_zero, se_one, se_two };
 enum small_signed_enum { sse_minus_one = -1, sse_zero, sse_one };
 
+/*
+ * The same three values with the narrowest storage the compiler
+ * allows, for the enum_storage section.
+ */
+#ifdef __GNUC__
+enum __attribute__((packed)) packed_enum { pe_zero, pe_one, pe_two };
+#endif
+#ifdef ENUM_UNDERLYING_TYPE_SUPPORTED
+enum fixed_enum : unsigned char { fe_zero, fe_one, fe_two };
+#endif
+
 #ifdef GENERIC_SELECTION_SUPPORTED
     #define UNDERLYING_TYPE_NAME(type) \
         _Generic ((type)0, \
@@ -204,52 +532,78 @@ enum small_signed_enum { sse_minus_one = -1, sse_zero, sse_one };
     #define UNDERLYING_TYPE_NAME(type) "unable to determine"
 #endif
 
-#define SHOW_INTEGER_TYPE(type, endianness, min, max, show_underlying)\
-    do {                                                              \
-        const int size = sizeof(type) * CHAR_BIT;                     \
-        const int align = ALIGNOF(type) * CHAR_BIT;                   \
-        printf("[%s]\n", space_to_hyphen(#type));                     \
-        puts("    kind = integer_type");                              \
-        printf("    size = %d\n", size);                              \
-        if (min != 0) {                                               \
-            if (IS_SIGNED(type)) {                                    \
-                printf("    min = %s\n", signed_image(min));          \
-            }                                                         \
-            else {                                                    \
-                printf("    min = %s\n", unsigned_image(min));        \
-            }                                                         \
-        }                                                             \
-        if (max != 0) {                                               \
-            if (IS_SIGNED(type)) {                                    \
-                printf("    max = %s\n", signed_image(max));          \
-            }                                                         \
-            else {                                                    \
-                printf("    max = %s\n", unsigned_image(max));        \
-            }                                                         \
-        }                                                             \
-        printf("    signedness = %s\n",                               \
-               (IS_SIGNED(type) ? "signed" : "unsigned"));            \
-        if (endianness != NULL) {                                     \
-            printf("    endianness = %s\n", endianness);              \
-        }                                                             \
-        printf("    align = %d\n", align);                            \
-        if (size <= MAX_SIZE) {                                       \
-            integer_sizes[size] = true;                               \
-        }                                                             \
-        else {                                                        \
-            huge_integer = true;                                      \
-        }                                                             \
-        if (show_underlying) {                                        \
-            printf("    underlying_type = %s\n",                      \
-                   UNDERLYING_TYPE_NAME(type));                       \
-        }                                                             \
-        putchar('\n');                                                \
+/*
+ * min_image and max_image are the type's range, or NULL if unknown.
+ */
+#define SHOW_INTEGER_TYPE_WITH_RANGE(out, type, type_name, endianness, min_image, max_image, show_underlying) \
+    do {                                                                  \
+        const int size = sizeof(type) * CHAR_BIT;                         \
+        const int align = ALIGNOF(type) * CHAR_BIT;                       \
+        const char *const range_min = (min_image);                        \
+        const char *const range_max = (max_image);                        \
+        char name[NAME_SIZE];                                             \
+        fprintf(out, "[%s]\n", space_to_hyphen(name, type_name));         \
+        fputs("    kind = integer_type\n", out);                          \
+        fprintf(out, "    size = %d\n", size);                            \
+        if (range_min != NULL) {                                          \
+            fprintf(out, "    min = %s\n", range_min);                    \
+        }                                                                 \
+        if (range_max != NULL) {                                          \
+            fprintf(out, "    max = %s\n", range_max);                    \
+        }                                                                 \
+        fprintf(out, "    signedness = %s\n",                             \
+                (IS_SIGNED(type) ? "signed" : "unsigned"));               \
+        if (endianness != NULL) {                                         \
+            fprintf(out, "    endianness = %s\n", endianness);            \
+        }                                                                 \
+        fprintf(out, "    align = %d\n", align);                          \
+        if (size <= MAX_SIZE) {                                           \
+            integer_sizes[size] = true;                                   \
+        }                                                                 \
+        else {                                                            \
+            huge_integer = true;                                          \
+        }                                                                 \
+        if (show_underlying) {                                            \
+            fprintf(out, "    underlying_type = %s\n",                    \
+                    UNDERLYING_TYPE_NAME(type));                          \
+        }                                                                 \
+        putc('\n', out);                                                  \
+    } while(0)
+
+/*
+ * A min or max of 0 means it's unknown and isn't shown.
+ */
+#define SHOW_INTEGER_TYPE(out, type, endianness, min, max, show_underlying) \
+    do {                                                                  \
+        char min_image[IMAGE_SIZE];                                       \
+        char max_image[IMAGE_SIZE];                                       \
+        const char *min_string = NULL;                                    \
+        const char *max_string = NULL;                                    \
+        if (min != 0) {                                                   \
+            if (IS_SIGNED(type)) {                                        \
+                min_string = signed_image(min_image, min);                \
+            }                                                             \
+            else {                                                        \
+                min_string = unsigned_image(min_image, min);              \
+            }                                                             \
+        }                                                                 \
+        if (max != 0) {                                                   \
+            if (IS_SIGNED(type)) {                                        \
+                max_string = signed_image(max_image, max);                \
+            }                                                             \
+            else {                                                        \
+                max_string = unsigned_image(max_image, max);              \
+            }                                                             \
+        }                                                                 \
+        SHOW_INTEGER_TYPE_WITH_RANGE(out, type, #type, endianness,        \
+                                     min_string, max_string, show_underlying); \
     } while(0)
 
-#define SHOW_FLOATING_TYPE(type, mant_dig, min_exp, max_exp, one, minus_sixteen, one_million, show_underlying) \
+#define SHOW_FLOATING_TYPE_WITH_NAME(out, type, type_name, mant_dig, min_exp, max_exp, one, minus_sixteen, one_million, show_underlying) \
     do {                                                             \
         const int size = sizeof(type) * CHAR_BIT;                    \
         const int align = ALIGNOF(type) * CHAR_BIT;                  \
+        char name[NAME_SIZE];                                        \
         char *const hex_one = hex_image(&one, sizeof one);           \
         char *const hex_minus_sixteen                                \
             = hex_image(&minus_sixteen, sizeof minus_sixteen);       \
@@ -260,21 +614,21 @@ enum small_signed_enum { sse_minus_one = -1, sse_zero, sse_one };
         free(hex_one);                                               \
         free(hex_minus_sixteen);                                     \
         free(hex_one_million);                                       \
-        printf("[%s]\n", space_to_hyphen(#type));                    \
-        puts("    kind = floating_type");                            \
-        printf("    size = %d\n", size);                             \
-        printf("    alignment = %d\n", align);                       \
+        fprintf(out, "[%s]\n", space_to_hyphen(name, type_name));     \
+        fputs("    kind = floating_type\n", out);                    \
+        fprintf(out, "    size = %d\n", size);                       \
+        fprintf(out, "    alignment = %d\n", align);                 \
         if (mant_dig != 0) {                                         \
-            printf("    mantissa_bits = %d\n", mant_dig);            \
+            fprintf(out, "    mantissa_bits = %d\n", mant_dig);      \
         }                                                            \
         if (min_exp != 0) {                                          \
-            printf("    min_exp = %d\n", min_exp);                   \
+            fprintf(out, "    min_exp = %d\n", min_exp);             \
         }                                                            \
         if (max_exp != 0) {                                          \
-            printf("    max_exp = %d\n", max_exp);                   \
+            fprintf(out, "    max_exp = %d\n", max_exp);             \
         }                                                            \
         if (one != 0.0) {                                            \
-            printf("    looks_like = \"%s\"\n", looks_like);         \
+            fprintf(out, "    looks_like = \"%s\"\n", looks_like);   \
         }                                                            \
         if (size <= MAX_SIZE) {                                      \
             float_sizes[size] = true;                                \
@@ -283,24 +637,53 @@ enum small_signed_enum { sse_minus_one = -1, sse_zero, sse_one };
             huge_float = true;                                       \
         }                                                            \
         if (show_underlying) {                                       \
-            printf("    underlying_type = %s\n",                     \
-                   UNDERLYING_TYPE_NAME(type));                      \
+            fprintf(out, "    underlying_type = %s\n",               \
+                    UNDERLYING_TYPE_NAME(type));                     \
         }                                                            \
-        putchar('\n');                                               \
+        putc('\n', out);                                             \
     } while(0)
 
-#define SHOW_RAW_TYPE_WITH_NAME(type, name)            \
-    do {                                               \
-        const int size = sizeof(type) * CHAR_BIT;      \
-        const int align = ALIGNOF(type) * CHAR_BIT;    \
-        printf("[%s]\n", space_to_hyphen(#type));      \
-        puts("    kind = type");                       \
-        printf("    size = %d\n", size);               \
-        printf("    alignment = %d\n", align);         \
-        putchar('\n');                                 \
+#define SHOW_FLOATING_TYPE(out, type, mant_dig, min_exp, max_exp, one, minus_sixteen, one_million, show_underlying) \
+    SHOW_FLOATING_TYPE_WITH_NAME(out, type, #type, mant_dig, min_exp, max_exp, \
+                                 one, minus_sixteen, one_million, show_underlying)
+
+#define SHOW_RAW_TYPE_WITH_NAME(out, type, type_name)              \
+    do {                                                           \
+        const int size = sizeof(type) * CHAR_BIT;                  \
+        const int align = ALIGNOF(type) * CHAR_BIT;                \
+        char name[NAME_SIZE];                                      \
+        fprintf(out, "[%s]\n", space_to_hyphen(name, #type));      \
+        fputs("    kind = type\n", out);                           \
+        fprintf(out, "    size = %d\n", size);                     \
+        fprintf(out, "    alignment = %d\n", align);               \
+        putc('\n', out);                                           \
     } while(0)
 
-#define SHOW_RAW_TYPE(type) SHOW_RAW_TYPE_WITH_NAME(type, #type)
+#define SHOW_RAW_TYPE(out, type) SHOW_RAW_TYPE_WITH_NAME(out, type, #type)
+
+/*
+ * A complex type has the same representation as an array of two
+ * elements of the corresponding real type; layout shows which element
+ * is which.
+ */
+#define SHOW_COMPLEX_TYPE(out, type, real_type)                    \
+    do {                                                           \
+        const int size = sizeof(type) * CHAR_BIT;                  \
+        const int align = ALIGNOF(type) * CHAR_BIT;                \
+        const type z = (real_type)1.0 + (real_type)2.0 * I;        \
+        real_type parts[2];                                        \
+        char name[NAME_SIZE];                                      \
+        memcpy(parts, &z, sizeof parts);                           \
+        fprintf(out, "[%s]\n", space_to_hyphen(name, #type));      \
+        fputs("    kind = complex_type\n", out);                   \
+        fprintf(out, "    size = %d\n", size);                     \
+        fprintf(out, "    alignment = %d\n", align);               \
+        fprintf(out, "    layout = %s\n",                          \
+                parts[0] == 1 && parts[1] == 2 ? "real-imaginary" : \
+                parts[0] == 2 && parts[1] == 1 ? "imaginary-real" : \
+                "unknown");                                        \
+        putc('\n', out);                                           \
+    } while(0)
 
 #define DEFINE_ENDIANNESS_FUNCTION(the_type, func_name) \
 static char *func_name(void) {           \
@@ -357,6 +740,19 @@ DEFINE_ENDIANNESS_FUNCTION(intmax_t,           intmax_t_endianness)
 DEFINE_ENDIANNESS_FUNCTION(uintmax_t,          uintmax_t_endianness)
 #endif
 
+#ifdef INT128_EXISTS
+DEFINE_ENDIANNESS_FUNCTION(int128,             int128_endianness)
+DEFINE_ENDIANNESS_FUNCTION(uint128,            uint128_endianness)
+#endif
+#ifdef BITINT_128_EXISTS
+DEFINE_ENDIANNESS_FUNCTION(bitint_128,         bitint_128_endianness)
+DEFINE_ENDIANNESS_FUNCTION(ubitint_128,        ubitint_128_endianness)
+#endif
+#ifdef BITINT_256_EXISTS
+DEFINE_ENDIANNESS_FUNCTION(bitint_256,         bitint_256_endianness)
+DEFINE_ENDIANNESS_FUNCTION(ubitint_256,        ubitint_256_endianness)
+#endif
+
 DEFINE_ENDIANNESS_FUNCTION(ptrdiff_t,          ptrdiff_t_endianness)
 DEFINE_ENDIANNESS_FUNCTION(size_t,             size_t_endianness)
 DEFINE_ENDIANNESS_FUNCTION(wchar_t,            wchar_t_endianness)
@@ -409,26 +805,61 @@ static void set_formats(void) {
 #endif
 }
 
-#define PRINT_SIGNED(n) printf(longest_signed_format, (longest_signed)n)
-#define PRINT_UnSIGNED(n) printf(longest_unsigned_format, (longest_unsigned)n)
+#define PRINT_SIGNED(n) fprintf(out, longest_signed_format, (longest_signed)n)
+#define PRINT_UnSIGNED(n) fprintf(out, longest_unsigned_format, (longest_unsigned)n)
 
-static char *signed_image(longest_signed n) {
-    static char result[CHAR_BIT * sizeof (longest_signed)];
+static char *signed_image(char *result, longest_signed n) {
     sprintf(result, longest_signed_format, n);
     return result;
 }
 
-static char *unsigned_image(longest_unsigned n) {
-    static char result[CHAR_BIT * sizeof (longest_unsigned)];
+static char *unsigned_image(char *result, longest_unsigned n) {
     sprintf(result, longest_unsigned_format, n);
     return result;
 }
 
-static void check_size(const char *kind, bool sizes[], int size) {
+/*
+ * Like signed_image() and unsigned_image(), for the extended integer
+ * types.  The result buffer needs WIDE_IMAGE_SIZE characters.
+ */
+#define WIDE_IMAGE_SIZE 80
+
+#define DEFINE_WIDE_IMAGE_FUNCTIONS(name, stype, utype)                   \
+static char *name##_unsigned_image(char *result, utype n) {               \
+    char digits[WIDE_IMAGE_SIZE];                                         \
+    int i = WIDE_IMAGE_SIZE - 1;                                          \
+    digits[i] = '\0';                                                     \
+    do {                                                                  \
+        digits[--i] = (char)('0' + (int)(n % 10));                        \
+        n /= 10;                                                          \
+    } while (n != 0);                                                     \
+    strcpy(result, digits + i);                                           \
+    return result;                                                        \
+}                                                                         \
+static char *name##_signed_image(char *result, stype n) {                 \
+    if (n < 0) {                                                          \
+        result[0] = '-';                                                  \
+        name##_unsigned_image(result + 1, (utype)0 - (utype)n);           \
+        return result;                                                    \
+    }                                                                     \
+    return name##_unsigned_image(result, (utype)n);                       \
+}
+
+#ifdef INT128_EXISTS
+DEFINE_WIDE_IMAGE_FUNCTIONS(int128, int128, uint128)
+#endif
+#ifdef BITINT_128_EXISTS
+DEFINE_WIDE_IMAGE_FUNCTIONS(bitint_128, bitint_128, ubitint_128)
+#endif
+#ifdef BITINT_256_EXISTS
+DEFINE_WIDE_IMAGE_FUNCTIONS(bitint_256, bitint_256, ubitint_256)
+#endif
+
+static void check_size(FILE *out, const char *kind, bool sizes[], int size) {
     if (! sizes[size]) {
-        printf("[comment-%d]\n", comment_index++);
-        printf("    comment = \"There is no %d-bit %s type\"\n", size, kind);
-        putchar('\n');
+        fprintf(out, "[comment-%d]\n", comment_index++);
+        fprintf(out, "    comment = \"There is no %d-bit %s type\"\n", size, kind);
+        putc('\n', out);
     }
 } /* check_size */
 
@@ -465,7 +896,35 @@ static char *floating_looks_like(const char *one, const char *minus_sixteen, con
     printf("            1.0e6 = %s\n", one_million);
 #endif
 
-    if (strcmp(one,           "3f800000") == 0 &&
+    if (strcmp(one,           "3c00") == 0 &&
+        strcmp(minus_sixteen, "cc00") == 0 &&
+        strcmp(one_million,   "7c00") == 0)
+    {
+        return "16-bit IEEE, big-endian";
+    }
+
+    else if (strcmp(one,           "003c") == 0 &&
+             strcmp(minus_sixteen, "00cc") == 0 &&
+             strcmp(one_million,   "007c") == 0)
+    {
+        return "16-bit IEEE, little-endian";
+    }
+
+    else if (strcmp(one,           "3f80") == 0 &&
+             strcmp(minus_sixteen, "c180") == 0 &&
+             strcmp(one_million,   "4974") == 0)
+    {
+        return "16-bit bfloat16, big-endian";
+    }
+
+    else if (strcmp(one,           "803f") == 0 &&
+             strcmp(minus_sixteen, "80c1") == 0 &&
+             strcmp(one_million,   "7449") == 0)
+    {
+        return "16-bit bfloat16, little-endian";
+    }
+
+    else if (strcmp(one,           "3f800000") == 0 &&
         strcmp(minus_sixteen, "c1800000") == 0 &&
         strcmp(one_million,   "49742400") == 0)
     {
@@ -500,6 +959,13 @@ static char *floating_looks_like(const char *one, const char *minus_sixteen, con
         return "SPARC/HPPA-style 128-bit IEEE, big-endian";
     }
 
+    else if (strcmp(one,      "0000000000000000000000000000ff3f") == 0 &&
+        strcmp(minus_sixteen, "000000000000000000000000000003c0") == 0 &&
+        strcmp(one_million,   "00000000000000000000000048e81240") == 0)
+    {
+        return "128-bit IEEE, little-endian";
+    }
+
     else if (strcmp(one,      "3ff00000000000000000000000000000") == 0 &&
         strcmp(minus_sixteen, "c0300000000000008000000000000000") == 0 &&
         strcmp(one_million,   "412e8480000000000000000000000000") == 0)
@@ -514,6 +980,13 @@ static char *floating_looks_like(const char *one, const char *minus_sixteen, con
         return "96-bit IEEE, little-endian";
     }
 
+    else if (strcmp(one,      "0000000000000080ff3f000000000000") == 0 &&
+        strcmp(minus_sixteen, "000000000000008003c0000000000000") == 0 &&
+        strcmp(one_million,   "00000000000024f41240000000000000") == 0)
+    {
+        return "80-bit IEEE extended in 128 bits, little-endian";
+    }
+
     else if (strcmp(one,      "4001800000000000") == 0 &&
         strcmp(minus_sixteen, "c005800000000000") == 0 &&
         strcmp(one_million,   "4014f42400000000") == 0)
@@ -590,15 +1063,51 @@ char *dupstr(char *s) {
     return result;
 }
 
-static void show_configuration(int argc, char **argv) {
-    puts("[configuration]");
-    printf("    SHOW_C_TYPES_VERSION = %s\n", SHOW_C_TYPES_VERSION);
+/*
+ * Returns true if arg is one of the options handled by main.  All
+ * other arguments, including any others starting with "--", are
+ * recorded in the configuration section, as they always have been.
+ * An option name ending in "=" takes a value.
+ */
+static bool is_option(const char *arg) {
+    static const char *const options[] = {
+        "--sections=", "--jobs=", "--list-sections",
+#ifdef ENABLE_BENCHMARKS
+        "--statistics", "--counters", "--cpu=",
+#endif
+    };
+    size_t i;
+    for (i = 0; i < sizeof options / sizeof options[0]; i ++) {
+        const size_t len = strlen(options[i]);
+        if (options[i][len - 1] == '=' ? strncmp(arg, options[i], len) == 0
+                                       : strcmp(arg, options[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * The command-line arguments, for show_configuration().
+ */
+static int program_argc;
+static char **program_argv;
+
+static void show_configuration(FILE *out) {
+    const int argc = program_argc;
+    char **const argv = program_argv;
+    fputs("[configuration]\n", out);
+    fprintf(out, "    SHOW_C_TYPES_VERSION = %s\n", SHOW_C_TYPES_VERSION);
     if (argc > 1) {
         int i;
         for (i = 1; i < argc; i ++) {
-            char *ptr_equals = strchr(argv[i], '=');
+            char *ptr_equals;
+            if (is_option(argv[i])) {
+                continue;
+            }
+            ptr_equals = strchr(argv[i], '=');
             if (ptr_equals == NULL) {
-                printf("    arg-%d = %s\n", i, argv[i]);
+                fprintf(out, "    arg-%d = %s\n", i, argv[i]);
             }
             else {
                 char *const arg = dupstr(argv[i]);
@@ -608,142 +1117,147 @@ static void show_configuration(int argc, char **argv) {
                 *ptr_equals = '\0';
                 key = arg;
                 value = ptr_equals + 1;
-                printf("    %s = %s\n", key, value);
+                fprintf(out, "    %s = %s\n", key, value);
                 free(arg);
             }
         }
     }
-    putchar('\n');
+    putc('\n', out);
 }
 
-static void show_predefined_macros(void) {
-    puts("[predefined_macros]");
+static void show_predefined_macros(FILE *out) {
+    fputs("[predefined_macros]\n", out);
 #ifdef __STDC__
-    printf("    __STDC__ = %d\n", __STDC__);
+    fprintf(out, "    __STDC__ = %d\n", __STDC__);
 #else
-    puts("    __STDC__ = undefined");
+    fputs("    __STDC__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_HOSTED__
-    printf("    __STDC_HOSTED__ = %d\n", __STDC_HOSTED__);
+    fprintf(out, "    __STDC_HOSTED__ = %d\n", __STDC_HOSTED__);
 #else
-    puts("    __STDC_HOSTED__ = undefined");
+    fputs("    __STDC_HOSTED__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_VERSION__
-    printf("    __STDC_VERSION__ = %ldL\n", __STDC_VERSION__);
+    fprintf(out, "    __STDC_VERSION__ = %ldL\n", __STDC_VERSION__);
 #else
-    puts("    __STDC_VERSION__ = undefined");
+    fputs("    __STDC_VERSION__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_ISO_10646__
-    printf("    __STDC_ISO_10646__ = %ldL\n", __STDC_ISO_10646__);
+    fprintf(out, "    __STDC_ISO_10646__ = %ldL\n", __STDC_ISO_10646__);
 #else
-    puts("    __STDC_ISO_10646__ = undefined");
+    fputs("    __STDC_ISO_10646__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_MB_MIGHT_NEQ_WC__
-    printf("    __STDC_MB_MIGHT_NEQ_WC__ = %d\n", __STDC_MB_MIGHT_NEQ_WC__);
+    fprintf(out, "    __STDC_MB_MIGHT_NEQ_WC__ = %d\n", __STDC_MB_MIGHT_NEQ_WC__);
 #else
-    puts("    __STDC_MB_MIGHT_NEQ_WC__ = undefined");
+    fputs("    __STDC_MB_MIGHT_NEQ_WC__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_UTF_16__
-    printf("    __STDC_UTF_16__ = %d\n", __STDC_UTF_16__);
+    fprintf(out, "    __STDC_UTF_16__ = %d\n", __STDC_UTF_16__);
 #else
-    puts("    __STDC_UTF_16__ = undefined");
+    fputs("    __STDC_UTF_16__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_UTF_32__
-    printf("    __STDC_UTF_32__ = %d\n", __STDC_UTF_32__);
+    fprintf(out, "    __STDC_UTF_32__ = %d\n", __STDC_UTF_32__);
 #else
-    puts("    __STDC_UTF_32__ = undefined");
+    fputs("    __STDC_UTF_32__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_ANALYZABLE__
-    printf("    __STDC_ANALYZABLE__ = %d\n", __STDC_ANALYZABLE__);
+    fprintf(out, "    __STDC_ANALYZABLE__ = %d\n", __STDC_ANALYZABLE__);
 #else
-    puts("    __STDC_ANALYZABLE__ = undefined");
+    fputs("    __STDC_ANALYZABLE__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_IEC_559_COMPLEX__
-    printf("    __STDC_IEC_559_COMPLEX__ = %d\n", __STDC_IEC_559_COMPLEX__);
+    fprintf(out, "    __STDC_IEC_559_COMPLEX__ = %d\n", __STDC_IEC_559_COMPLEX__);
 #else
-    puts("    __STDC_IEC_559_COMPLEX__ = undefined");
+    fputs("    __STDC_IEC_559_COMPLEX__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_LIB_EXT1__
-    printf("    __STDC_LIB_EXT1__ = %d\n", __STDC_LIB_EXT1__);
+    fprintf(out, "    __STDC_LIB_EXT1__ = %d\n", __STDC_LIB_EXT1__);
 #else
-    puts("    __STDC_LIB_EXT1__ = undefined");
+    fputs("    __STDC_LIB_EXT1__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_NO_ATOMICS__
-    printf("    __STDC_NO_ATOMICS__ = %d\n", __STDC_NO_ATOMICS__);
+    fprintf(out, "    __STDC_NO_ATOMICS__ = %d\n", __STDC_NO_ATOMICS__);
 #else
-    puts("    __STDC_NO_ATOMICS__ = undefined");
+    fputs("    __STDC_NO_ATOMICS__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_NO_COMPLEX__
-    printf("    __STDC_NO_COMPLEX__ = %d\n", __STDC_NO_COMPLEX__);
+    fprintf(out, "    __STDC_NO_COMPLEX__ = %d\n", __STDC_NO_COMPLEX__);
 #else
-    puts("    __STDC_NO_COMPLEX__ = undefined");
+    fputs("    __STDC_NO_COMPLEX__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_NO_THREADS__
-    printf("    __STDC_NO_THREADS__ = %d\n", __STDC_NO_THREADS__);
+    fprintf(out, "    __STDC_NO_THREADS__ = %d\n", __STDC_NO_THREADS__);
 #else
-    puts("    __STDC_NO_THREADS__ = undefined");
+    fputs("    __STDC_NO_THREADS__ = undefined\n", out);
 #endif
 
 #ifdef __STDC_NO_VLA__
-    printf("    __STDC_NO_VLA__ = %d\n", __STDC_NO_VLA__);
+    fprintf(out, "    __STDC_NO_VLA__ = %d\n", __STDC_NO_VLA__);
 #else
-    puts("    __STDC_NO_VLA__ = undefined");
+    fputs("    __STDC_NO_VLA__ = undefined\n", out);
 #endif
 
-    putchar('\n');
+    putc('\n', out);
 }
 
-static void show_limits_h(void) {
-    puts("[<limits.h>]");
-    puts("    kind = header");
-    printf("    CHAR_BIT = %d\n", (int)CHAR_BIT);
-    printf("    SCHAR_MIN = %d\n", (int)SCHAR_MIN);
-    printf("    SCHAR_MAX = %d\n", (int)SCHAR_MAX);
-    printf("    UCHAR_MAX = %d\n", (int)UCHAR_MAX);
-    printf("    CHAR_MIN = %d\n", (int)CHAR_MIN);
-    printf("    CHAR_MAX = %d\n", (int)CHAR_MAX);
+static void show_limits_h(FILE *out) {
+    fputs("[<limits.h>]\n", out);
+    fputs("    kind = header\n", out);
+    fprintf(out, "    CHAR_BIT = %d\n", (int)CHAR_BIT);
+    fprintf(out, "    SCHAR_MIN = %d\n", (int)SCHAR_MIN);
+    fprintf(out, "    SCHAR_MAX = %d\n", (int)SCHAR_MAX);
+    fprintf(out, "    UCHAR_MAX = %d\n", (int)UCHAR_MAX);
+    fprintf(out, "    CHAR_MIN = %d\n", (int)CHAR_MIN);
+    fprintf(out, "    CHAR_MAX = %d\n", (int)CHAR_MAX);
 #ifdef MB_LEN_MAX
-    printf("    MB_LEN_MAX = %d\n", (int)MB_LEN_MAX);
-#else
-    puts("    MB_LEN_MAX = undefined");
-#endif
-    printf("    SHRT_MIN = %d\n", (int)SHRT_MIN);
-    printf("    SHRT_MAX = %d\n", (int)SHRT_MAX);
-    printf("    USHRT_MAX = %d\n", (int)USHRT_MAX);
-    printf("    INT_MIN = %d\n", INT_MIN);
-    printf("    INT_MAX = %d\n", INT_MAX);
-    printf("    UINT_MAX = %u\n", UINT_MAX);
-    printf("    LONG_MIN = %ld\n", LONG_MIN);
-    printf("    LONG_MAX = %ld\n", LONG_MAX);
-    printf("    ULONG_MAX = %lu\n", ULONG_MAX);
+    fprintf(out, "    MB_LEN_MAX = %d\n", (int)MB_LEN_MAX);
+#else
+    fputs("    MB_LEN_MAX = undefined\n", out);
+#endif
+    fprintf(out, "    SHRT_MIN = %d\n", (int)SHRT_MIN);
+    fprintf(out, "    SHRT_MAX = %d\n", (int)SHRT_MAX);
+    fprintf(out, "    USHRT_MAX = %d\n", (int)USHRT_MAX);
+    fprintf(out, "    INT_MIN = %d\n", INT_MIN);
+    fprintf(out, "    INT_MAX = %d\n", INT_MAX);
+    fprintf(out, "    UINT_MAX = %u\n", UINT_MAX);
+    fprintf(out, "    LONG_MIN = %ld\n", LONG_MIN);
+    fprintf(out, "    LONG_MAX = %ld\n", LONG_MAX);
+    fprintf(out, "    ULONG_MAX = %lu\n", ULONG_MAX);
 #ifdef LLONG_MIN
-    printf("    LLONG_MIN = %lld\n", LLONG_MIN);
+    fprintf(out, "    LLONG_MIN = %lld\n", LLONG_MIN);
 #else
-    puts("    LLONG_MIN = undefined");
+    fputs("    LLONG_MIN = undefined\n", out);
 #endif
 #ifdef LLONG_MAX
-    printf("    LLONG_MAX = %lld\n", LLONG_MAX);
+    fprintf(out, "    LLONG_MAX = %lld\n", LLONG_MAX);
 #else
-    puts("    LLONG_MIN = undefined");
+    fputs("    LLONG_MIN = undefined\n", out);
 #endif
 #ifdef ULLONG_MAX
-    printf("    ULLONG_MAX = %llu\n", ULLONG_MAX);
+    fprintf(out, "    ULLONG_MAX = %llu\n", ULLONG_MAX);
+#else
+    fputs("    ULLONG_MIN = undefined\n", out);
+#endif
+#ifdef BITINT_MAXWIDTH
+    fprintf(out, "    BITINT_MAXWIDTH = %ld\n", (long)BITINT_MAXWIDTH);
 #else
-    puts("    ULLONG_MIN = undefined");
+    fputs("    BITINT_MAXWIDTH = undefined\n", out);
 #endif
-    putchar('\n');
+    putc('\n', out);
 }
 
 static char *FLT_ROUNDS_meaning(int flt_rounds) {
@@ -776,411 +1290,5355 @@ static char *HAS_SUBNORM_meaning(int has_subnorm) {
     }
 }
 
-static void show_float_h(void) {
-    puts("[<float.h>]");
-    puts("    kind = header");
+static void show_float_h(FILE *out) {
+    fputs("[<float.h>]\n", out);
+    fputs("    kind = header\n", out);
 
 #ifdef FLT_ROUNDS
-    printf("    FLT_ROUNDS = %d\n", FLT_ROUNDS);
-    printf("    FLT_ROUNDS_meaning = \"%s\"\n", FLT_ROUNDS_meaning(FLT_ROUNDS));
+    fprintf(out, "    FLT_ROUNDS = %d\n", FLT_ROUNDS);
+    fprintf(out, "    FLT_ROUNDS_meaning = \"%s\"\n", FLT_ROUNDS_meaning(FLT_ROUNDS));
 #else
-    puts("    FLT_ROUNDS = undefined");
+    fputs("    FLT_ROUNDS = undefined\n", out);
 #endif
 
 #ifdef FLT_EVAL_METHOD
-    printf("    FLT_EVAL_METHOD = %d\n", FLT_EVAL_METHOD);
-    printf("    FLT_EVAL_METHOD_meaning = \"%s\"\n", FLT_EVAL_METHOD_meaning(FLT_EVAL_METHOD));
+    fprintf(out, "    FLT_EVAL_METHOD = %d\n", FLT_EVAL_METHOD);
+    fprintf(out, "    FLT_EVAL_METHOD_meaning = \"%s\"\n", FLT_EVAL_METHOD_meaning(FLT_EVAL_METHOD));
 #else
-    puts("    FLT_EVAL_METHOD = undefined");
+    fputs("    FLT_EVAL_METHOD = undefined\n", out);
 #endif
 
 #ifdef FLT_HAS_SUBNORM
-    printf("    FLT_HAS_SUBNORM = %d\n", FLT_HAS_SUBNORM);
-    printf("    FLT_HAS_SUBNORM_meaning = \"%s\"\n", HAS_SUBNORM_meaning(FLT_HAS_SUBNORM));
+    fprintf(out, "    FLT_HAS_SUBNORM = %d\n", FLT_HAS_SUBNORM);
+    fprintf(out, "    FLT_HAS_SUBNORM_meaning = \"%s\"\n", HAS_SUBNORM_meaning(FLT_HAS_SUBNORM));
 #else
-    puts("    FLT_HAS_SUBNORM = undefined");
+    fputs("    FLT_HAS_SUBNORM = undefined\n", out);
 #endif
 
 #ifdef DBL_HAS_SUBNORM
-    printf("    DBL_HAS_SUBNORM = %d\n", DBL_HAS_SUBNORM);
-    printf("    DBL_HAS_SUBNORM_meaning = \"%s\"\n", HAS_SUBNORM_meaning(DBL_HAS_SUBNORM));
+    fprintf(out, "    DBL_HAS_SUBNORM = %d\n", DBL_HAS_SUBNORM);
+    fprintf(out, "    DBL_HAS_SUBNORM_meaning = \"%s\"\n", HAS_SUBNORM_meaning(DBL_HAS_SUBNORM));
 #else
-    puts("    DBL_HAS_SUBNORM = undefined");
+    fputs("    DBL_HAS_SUBNORM = undefined\n", out);
 #endif
 
 #ifdef LDBL_HAS_SUBNORM
-    printf("    LDBL_HAS_SUBNORM = %d\n", LDBL_HAS_SUBNORM);
-    printf("    LDBL_HAS_SUBNORM_meaning = \"%s\"\n", HAS_SUBNORM_meaning(LDBL_HAS_SUBNORM));
+    fprintf(out, "    LDBL_HAS_SUBNORM = %d\n", LDBL_HAS_SUBNORM);
+    fprintf(out, "    LDBL_HAS_SUBNORM_meaning = \"%s\"\n", HAS_SUBNORM_meaning(LDBL_HAS_SUBNORM));
 #else
-    puts("    LDBL_HAS_SUBNORM = undefined");
+    fputs("    LDBL_HAS_SUBNORM = undefined\n", out);
 #endif
 
-    printf("    FLT_RADIX = %d\n", FLT_RADIX);
-    printf("    FLT_MANT_DIG = %d\n", FLT_MANT_DIG);
-    printf("    DBL_MANT_DIG = %d\n", DBL_MANT_DIG);
-    printf("    LDBL_MANT_DIG = %d\n", LDBL_MANT_DIG);
+    fprintf(out, "    FLT_RADIX = %d\n", FLT_RADIX);
+    fprintf(out, "    FLT_MANT_DIG = %d\n", FLT_MANT_DIG);
+    fprintf(out, "    DBL_MANT_DIG = %d\n", DBL_MANT_DIG);
+    fprintf(out, "    LDBL_MANT_DIG = %d\n", LDBL_MANT_DIG);
 
 #ifdef FLT_DECIMAL_DIG
-    printf("    FLT_DECIMAL_DIG = %d\n", FLT_DECIMAL_DIG);
+    fprintf(out, "    FLT_DECIMAL_DIG = %d\n", FLT_DECIMAL_DIG);
 #else
-    puts("    FLT_DECIMAL_DIG = undefined");
+    fputs("    FLT_DECIMAL_DIG = undefined\n", out);
 #endif
 #ifdef DBL_DECIMAL_DIG
-    printf("    DBL_DECIMAL_DIG = %d\n", DBL_DECIMAL_DIG);
+    fprintf(out, "    DBL_DECIMAL_DIG = %d\n", DBL_DECIMAL_DIG);
 #else
-    puts("    DBL_DECIMAL_DIG = undefined");
+    fputs("    DBL_DECIMAL_DIG = undefined\n", out);
 #endif
 #ifdef LDBL_DECIMAL_DIG
-    printf("    LDBL_DECIMAL_DIG = %d\n", LDBL_DECIMAL_DIG);
+    fprintf(out, "    LDBL_DECIMAL_DIG = %d\n", LDBL_DECIMAL_DIG);
 #else
-    puts("    LDBL_DECIMAL_DIG = undefined");
+    fputs("    LDBL_DECIMAL_DIG = undefined\n", out);
 #endif
 #ifdef DECIMAL_DIG
-    printf("    DECIMAL_DIG = %d\n", DECIMAL_DIG);
+    fprintf(out, "    DECIMAL_DIG = %d\n", DECIMAL_DIG);
 #else
-    puts("    DECIMAL_DIG = undefined");
+    fputs("    DECIMAL_DIG = undefined\n", out);
 #endif
 
-    printf("    FLT_DIG = %d\n", FLT_DIG);
-    printf("    DBL_DIG = %d\n", DBL_DIG);
+    fprintf(out, "    FLT_DIG = %d\n", FLT_DIG);
+    fprintf(out, "    DBL_DIG = %d\n", DBL_DIG);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_DIG = %d\n", LDBL_DIG);
+    fprintf(out, "    LDBL_DIG = %d\n", LDBL_DIG);
 #endif
 
-    printf("    FLT_MIN_EXP = %d\n", FLT_MIN_EXP);
-    printf("    DBL_MIN_EXP = %d\n", DBL_MIN_EXP);
+    fprintf(out, "    FLT_MIN_EXP = %d\n", FLT_MIN_EXP);
+    fprintf(out, "    DBL_MIN_EXP = %d\n", DBL_MIN_EXP);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_MIN_EXP = %d\n", LDBL_MIN_EXP);
+    fprintf(out, "    LDBL_MIN_EXP = %d\n", LDBL_MIN_EXP);
 #endif
 
-    printf("    FLT_MIN_10_EXP = %d\n", FLT_MIN_10_EXP);
-    printf("    DBL_MIN_10_EXP = %d\n", DBL_MIN_10_EXP);
+    fprintf(out, "    FLT_MIN_10_EXP = %d\n", FLT_MIN_10_EXP);
+    fprintf(out, "    DBL_MIN_10_EXP = %d\n", DBL_MIN_10_EXP);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_MIN_10_EXP = %d\n", LDBL_MIN_10_EXP);
+    fprintf(out, "    LDBL_MIN_10_EXP = %d\n", LDBL_MIN_10_EXP);
 #endif
 
-    printf("    FLT_MAX_EXP = %d\n", FLT_MAX_EXP);
-    printf("    DBL_MAX_EXP = %d\n", DBL_MAX_EXP);
+    fprintf(out, "    FLT_MAX_EXP = %d\n", FLT_MAX_EXP);
+    fprintf(out, "    DBL_MAX_EXP = %d\n", DBL_MAX_EXP);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_MAX_EXP = %d\n", LDBL_MAX_EXP);
+    fprintf(out, "    LDBL_MAX_EXP = %d\n", LDBL_MAX_EXP);
 #endif
 
-    printf("    FLT_MAX_10_EXP = %d\n", FLT_MAX_10_EXP);
-    printf("    DBL_MAX_10_EXP = %d\n", DBL_MAX_10_EXP);
+    fprintf(out, "    FLT_MAX_10_EXP = %d\n", FLT_MAX_10_EXP);
+    fprintf(out, "    DBL_MAX_10_EXP = %d\n", DBL_MAX_10_EXP);
 #ifdef LONG_DOUBLE_EXISTS
 #ifdef LDBL_MAX_10_EXP
-    printf("    LDBL_MAX_10_EXP = %d\n", LDBL_MAX_10_EXP);
+    fprintf(out, "    LDBL_MAX_10_EXP = %d\n", LDBL_MAX_10_EXP);
 #else
-    printf("    LDBL_MAX_10_EXP = undefined\n");
+    fprintf(out, "    LDBL_MAX_10_EXP = undefined\n");
 #endif
 #endif
 
-    printf("    FLT_MAX = %e\n", FLT_MAX);
-    printf("    DBL_MAX = %e\n", DBL_MAX);
+    fprintf(out, "    FLT_MAX = %e\n", FLT_MAX);
+    fprintf(out, "    DBL_MAX = %e\n", DBL_MAX);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_MAX = %Le\n", LDBL_MAX);
+    fprintf(out, "    LDBL_MAX = %Le\n", LDBL_MAX);
 #endif
 
-    printf("    FLT_EPSILON = %e\n", FLT_EPSILON);
-    printf("    DBL_EPSILON = %e\n", DBL_EPSILON);
+    fprintf(out, "    FLT_EPSILON = %e\n", FLT_EPSILON);
+    fprintf(out, "    DBL_EPSILON = %e\n", DBL_EPSILON);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_EPSILON = %Le\n", LDBL_EPSILON);
+    fprintf(out, "    LDBL_EPSILON = %Le\n", LDBL_EPSILON);
 #endif
 
-    printf("    FLT_MIN = %e\n", FLT_MIN);
-    printf("    DBL_MIN = %e\n", DBL_MIN);
+    fprintf(out, "    FLT_MIN = %e\n", FLT_MIN);
+    fprintf(out, "    DBL_MIN = %e\n", DBL_MIN);
 #ifdef LONG_DOUBLE_EXISTS
-    printf("    LDBL_MIN = %Le\n", LDBL_MIN);
+    fprintf(out, "    LDBL_MIN = %Le\n", LDBL_MIN);
 #endif
 
 #ifdef FLT_TRUE_MIN
-    printf("    FLT_TRUE_MIN = %e\n", FLT_TRUE_MIN);
+    fprintf(out, "    FLT_TRUE_MIN = %e\n", FLT_TRUE_MIN);
 #else
-    puts("    FLT_TRUE_MIN = undefined");
+    fputs("    FLT_TRUE_MIN = undefined\n", out);
 #endif
 #ifdef DBL_TRUE_MIN
-    printf("    DBL_TRUE_MIN = %e\n", DBL_TRUE_MIN);
+    fprintf(out, "    DBL_TRUE_MIN = %e\n", DBL_TRUE_MIN);
 #else
-    puts("    DBL_TRUE_MIN = undefined");
+    fputs("    DBL_TRUE_MIN = undefined\n", out);
 #endif
 #ifdef LDBL_TRUE_MIN
-    printf("    LDBL_TRUE_MIN = %Le\n", LDBL_TRUE_MIN);
+    fprintf(out, "    LDBL_TRUE_MIN = %Le\n", LDBL_TRUE_MIN);
 #else
-    puts("    LDBL_TRUE_MIN = undefined");
+    fputs("    LDBL_TRUE_MIN = undefined\n", out);
 #endif
 
-    putchar('\n');
+    putc('\n', out);
 }
 
-/* Not reentrant */
-static char *space_to_hyphen(const char *s) {
-    static char result[100];
+/*
+ * Copies s to result (which must have room for NAME_SIZE characters),
+ * replacing each space by a hyphen.
+ */
+static char *space_to_hyphen(char *result, const char *s) {
     int i;
-    strcpy(result, s);
-    for (i = 0; result[i] != '\0'; i ++) {
-        if (result[i] == ' ') {
-            result[i] = '-';
-        }
+    for (i = 0; s[i] != '\0' && i < NAME_SIZE - 1; i ++) {
+        result[i] = s[i] == ' ' ? '-' : s[i];
     }
+    result[i] = '\0';
     return result;
 }
 
-static void show_stdint_h(void) {
-    puts("[<stdint.h>]");
-    puts("    kind = header");
+static void show_stdint_h(FILE *out) {
+#ifdef STDINT_H_EXISTS
+    char image[IMAGE_SIZE];
+#endif
+
+    fputs("[<stdint.h>]\n", out);
+    fputs("    kind = header\n", out);
 #ifdef STDINT_H_EXISTS
-    puts("    header_exists = true");
+    fputs("    header_exists = true\n", out);
 
 #ifdef INT8_MIN
-    printf("    INT8_MIN = %s\n", signed_image(INT8_MIN));
+    fprintf(out, "    INT8_MIN = %s\n", signed_image(image, INT8_MIN));
 #else
-    puts("    INT8_MIN = undefined");
+    fputs("    INT8_MIN = undefined\n", out);
 #endif
 #ifdef INT8_MAX
-    printf("    INT8_MAX = %s\n", signed_image(INT8_MAX));
+    fprintf(out, "    INT8_MAX = %s\n", signed_image(image, INT8_MAX));
 #else
-    puts("    INT8_MAX = undefined");
+    fputs("    INT8_MAX = undefined\n", out);
 #endif
 #ifdef UINT8_MAX
-    printf("    UINT8_MAX = %s\n", unsigned_image(UINT8_MAX));
+    fprintf(out, "    UINT8_MAX = %s\n", unsigned_image(image, UINT8_MAX));
 #else
-    puts("    UINT8_MAX = undefined");
+    fputs("    UINT8_MAX = undefined\n", out);
 #endif
 
 #ifdef INT16_MIN
-    printf("    INT16_MIN = %s\n", signed_image(INT16_MIN));
+    fprintf(out, "    INT16_MIN = %s\n", signed_image(image, INT16_MIN));
 #else
-    puts("    INT16_MIN = undefined");
+    fputs("    INT16_MIN = undefined\n", out);
 #endif
 #ifdef INT16_MAX
-    printf("    INT16_MAX = %s\n", signed_image(INT16_MAX));
+    fprintf(out, "    INT16_MAX = %s\n", signed_image(image, INT16_MAX));
 #else
-    puts("    INT16_MAX = undefined");
+    fputs("    INT16_MAX = undefined\n", out);
 #endif
 #ifdef UINT16_MAX
-    printf("    UINT16_MAX = %s\n", unsigned_image(UINT16_MAX));
+    fprintf(out, "    UINT16_MAX = %s\n", unsigned_image(image, UINT16_MAX));
 #else
-    puts("    UINT16_MAX = undefined");
+    fputs("    UINT16_MAX = undefined\n", out);
 #endif
 
 #ifdef INT32_MIN
-    printf("    INT32_MIN = %s\n", signed_image(INT32_MIN));
+    fprintf(out, "    INT32_MIN = %s\n", signed_image(image, INT32_MIN));
 #else
-    puts("    INT32_MIN = undefined");
+    fputs("    INT32_MIN = undefined\n", out);
 #endif
 #ifdef INT32_MAX
-    printf("    INT32_MAX = %s\n", signed_image(INT32_MAX));
+    fprintf(out, "    INT32_MAX = %s\n", signed_image(image, INT32_MAX));
 #else
-    puts("    INT32_MAX = undefined");
+    fputs("    INT32_MAX = undefined\n", out);
 #endif
 #ifdef UINT32_MAX
-    printf("    UINT32_MAX = %s\n", unsigned_image(UINT32_MAX));
+    fprintf(out, "    UINT32_MAX = %s\n", unsigned_image(image, UINT32_MAX));
 #else
-    puts("    UINT32_MAX = undefined");
+    fputs("    UINT32_MAX = undefined\n", out);
 #endif
 
 #ifdef INT64_MIN
-    printf("    INT64_MIN = %s\n", signed_image(INT64_MIN));
+    fprintf(out, "    INT64_MIN = %s\n", signed_image(image, INT64_MIN));
 #else
-    puts("    INT64_MIN = undefined");
+    fputs("    INT64_MIN = undefined\n", out);
 #endif
 #ifdef INT64_MAX
-    printf("    INT64_MAX = %s\n", signed_image(INT64_MAX));
+    fprintf(out, "    INT64_MAX = %s\n", signed_image(image, INT64_MAX));
 #else
-    puts("    INT64_MAX = undefined");
+    fputs("    INT64_MAX = undefined\n", out);
 #endif
 #ifdef UINT64_MAX
-    printf("    UINT64_MAX = %s\n", unsigned_image(UINT64_MAX));
+    fprintf(out, "    UINT64_MAX = %s\n", unsigned_image(image, UINT64_MAX));
 #else
-    puts("    UINT64_MAX = undefined");
+    fputs("    UINT64_MAX = undefined\n", out);
 #endif
 
 #ifdef INTMAX_MIN
-    printf("    INTMAX_MIN = %s\n", signed_image(INTMAX_MIN));
+    fprintf(out, "    INTMAX_MIN = %s\n", signed_image(image, INTMAX_MIN));
 #else
-    puts("    INTMAX_MIN = undefined");
+    fputs("    INTMAX_MIN = undefined\n", out);
 #endif
 #ifdef INTMAX_MAX
-    printf("    INTMAX_MAX = %s\n", signed_image(INTMAX_MAX));
+    fprintf(out, "    INTMAX_MAX = %s\n", signed_image(image, INTMAX_MAX));
 #else
-    puts("    INTMAX_MAX = undefined");
+    fputs("    INTMAX_MAX = undefined\n", out);
 #endif
 #ifdef UINTMAX_MAX
-    printf("    UINTMAX_MAX = %s\n", unsigned_image(UINTMAX_MAX));
-#else
-    puts("    UINTMAX_MAX = undefined");
-#endif
-
-    printf("    INT_LEAST8_MIN = %s\n", signed_image(INT_LEAST8_MIN));
-    printf("    INT_LEAST8_MAX = %s\n", signed_image(INT_LEAST8_MAX));
-    printf("    UINT_LEAST8_MAX = %s\n", unsigned_image(UINT_LEAST8_MAX));
-    printf("    INT_LEAST16_MIN = %s\n", signed_image(INT_LEAST16_MIN));
-    printf("    INT_LEAST16_MAX = %s\n", signed_image(INT_LEAST16_MAX));
-    printf("    UINT_LEAST16_MAX = %s\n", unsigned_image(UINT_LEAST16_MAX));
-    printf("    INT_LEAST32_MIN = %s\n", signed_image(INT_LEAST32_MIN));
-    printf("    INT_LEAST32_MAX = %s\n", signed_image(INT_LEAST32_MAX));
-    printf("    UINT_LEAST32_MAX = %s\n", unsigned_image(UINT_LEAST32_MAX));
-    printf("    INT_LEAST64_MIN = %s\n", signed_image(INT_LEAST64_MIN));
-    printf("    INT_LEAST64_MAX = %s\n", signed_image(INT_LEAST64_MAX));
-    printf("    UINT_LEAST64_MAX = %s\n", unsigned_image(UINT_LEAST64_MAX));
-
-    printf("    INT_FAST8_MIN = %s\n", signed_image(INT_FAST8_MIN));
-    printf("    INT_FAST8_MAX = %s\n", signed_image(INT_FAST8_MAX));
-    printf("    UINT_FAST8_MAX = %s\n", unsigned_image(UINT_FAST8_MAX));
-    printf("    INT_FAST16_MIN = %s\n", signed_image(INT_FAST16_MIN));
-    printf("    INT_FAST16_MAX = %s\n", signed_image(INT_FAST16_MAX));
-    printf("    UINT_FAST16_MAX = %s\n", unsigned_image(UINT_FAST16_MAX));
-    printf("    INT_FAST32_MIN = %s\n", signed_image(INT_FAST32_MIN));
-    printf("    INT_FAST32_MAX = %s\n", signed_image(INT_FAST32_MAX));
-    printf("    UINT_FAST32_MAX = %s\n", unsigned_image(UINT_FAST32_MAX));
-    printf("    INT_FAST64_MIN = %s\n", signed_image(INT_FAST64_MIN));
-    printf("    INT_FAST64_MAX = %s\n", signed_image(INT_FAST64_MAX));
-    printf("    UINT_FAST64_MAX = %s\n", unsigned_image(UINT_FAST64_MAX));
-
-    printf("    INTPTR_MIN = %s\n", signed_image(INTPTR_MIN));
-    printf("    INTPTR_MAX = %s\n", signed_image(INTPTR_MAX));
-    printf("    UINTPTR_MAX = %s\n", unsigned_image(UINTPTR_MAX));
-
-    printf("    PTRDIFF_MIN = %s\n", signed_image(PTRDIFF_MIN));
-    printf("    PTRDIFF_MAX = %s\n", signed_image(PTRDIFF_MAX));
+    fprintf(out, "    UINTMAX_MAX = %s\n", unsigned_image(image, UINTMAX_MAX));
+#else
+    fputs("    UINTMAX_MAX = undefined\n", out);
+#endif
+
+    fprintf(out, "    INT_LEAST8_MIN = %s\n", signed_image(image, INT_LEAST8_MIN));
+    fprintf(out, "    INT_LEAST8_MAX = %s\n", signed_image(image, INT_LEAST8_MAX));
+    fprintf(out, "    UINT_LEAST8_MAX = %s\n", unsigned_image(image, UINT_LEAST8_MAX));
+    fprintf(out, "    INT_LEAST16_MIN = %s\n", signed_image(image, INT_LEAST16_MIN));
+    fprintf(out, "    INT_LEAST16_MAX = %s\n", signed_image(image, INT_LEAST16_MAX));
+    fprintf(out, "    UINT_LEAST16_MAX = %s\n", unsigned_image(image, UINT_LEAST16_MAX));
+    fprintf(out, "    INT_LEAST32_MIN = %s\n", signed_image(image, INT_LEAST32_MIN));
+    fprintf(out, "    INT_LEAST32_MAX = %s\n", signed_image(image, INT_LEAST32_MAX));
+    fprintf(out, "    UINT_LEAST32_MAX = %s\n", unsigned_image(image, UINT_LEAST32_MAX));
+    fprintf(out, "    INT_LEAST64_MIN = %s\n", signed_image(image, INT_LEAST64_MIN));
+    fprintf(out, "    INT_LEAST64_MAX = %s\n", signed_image(image, INT_LEAST64_MAX));
+    fprintf(out, "    UINT_LEAST64_MAX = %s\n", unsigned_image(image, UINT_LEAST64_MAX));
+
+    fprintf(out, "    INT_FAST8_MIN = %s\n", signed_image(image, INT_FAST8_MIN));
+    fprintf(out, "    INT_FAST8_MAX = %s\n", signed_image(image, INT_FAST8_MAX));
+    fprintf(out, "    UINT_FAST8_MAX = %s\n", unsigned_image(image, UINT_FAST8_MAX));
+    fprintf(out, "    INT_FAST16_MIN = %s\n", signed_image(image, INT_FAST16_MIN));
+    fprintf(out, "    INT_FAST16_MAX = %s\n", signed_image(image, INT_FAST16_MAX));
+    fprintf(out, "    UINT_FAST16_MAX = %s\n", unsigned_image(image, UINT_FAST16_MAX));
+    fprintf(out, "    INT_FAST32_MIN = %s\n", signed_image(image, INT_FAST32_MIN));
+    fprintf(out, "    INT_FAST32_MAX = %s\n", signed_image(image, INT_FAST32_MAX));
+    fprintf(out, "    UINT_FAST32_MAX = %s\n", unsigned_image(image, UINT_FAST32_MAX));
+    fprintf(out, "    INT_FAST64_MIN = %s\n", signed_image(image, INT_FAST64_MIN));
+    fprintf(out, "    INT_FAST64_MAX = %s\n", signed_image(image, INT_FAST64_MAX));
+    fprintf(out, "    UINT_FAST64_MAX = %s\n", unsigned_image(image, UINT_FAST64_MAX));
+
+    fprintf(out, "    INTPTR_MIN = %s\n", signed_image(image, INTPTR_MIN));
+    fprintf(out, "    INTPTR_MAX = %s\n", signed_image(image, INTPTR_MAX));
+    fprintf(out, "    UINTPTR_MAX = %s\n", unsigned_image(image, UINTPTR_MAX));
+
+    fprintf(out, "    PTRDIFF_MIN = %s\n", signed_image(image, PTRDIFF_MIN));
+    fprintf(out, "    PTRDIFF_MAX = %s\n", signed_image(image, PTRDIFF_MAX));
 
 #ifdef SIG_ATOMIC_MIN
 #if SIG_ATOMIC_MIN == 0
-    printf("    SIG_ATOMIC_MIN = %s\n", unsigned_image(SIG_ATOMIC_MIN));
-    printf("    SIG_ATOMIC_MAX = %s\n", unsigned_image(SIG_ATOMIC_MAX));
+    fprintf(out, "    SIG_ATOMIC_MIN = %s\n", unsigned_image(image, SIG_ATOMIC_MIN));
+    fprintf(out, "    SIG_ATOMIC_MAX = %s\n", unsigned_image(image, SIG_ATOMIC_MAX));
 #else
-    printf("    SIG_ATOMIC_MIN = %s\n", signed_image(SIG_ATOMIC_MIN));
-    printf("    SIG_ATOMIC_MAX = %s\n", signed_image(SIG_ATOMIC_MAX));
+    fprintf(out, "    SIG_ATOMIC_MIN = %s\n", signed_image(image, SIG_ATOMIC_MIN));
+    fprintf(out, "    SIG_ATOMIC_MAX = %s\n", signed_image(image, SIG_ATOMIC_MAX));
 #endif
 #endif
 
-    printf("    SIZE_MAX = %s\n", unsigned_image(SIZE_MAX));
+    fprintf(out, "    SIZE_MAX = %s\n", unsigned_image(image, SIZE_MAX));
 
 #ifdef WCHAR_MIN
 #if WCHAR_MIN == 0
-    printf("    WCHAR_MIN = %s\n", unsigned_image(WCHAR_MIN));
-    printf("    WCHAR_MAX = %s\n", unsigned_image(WCHAR_MAX));
+    fprintf(out, "    WCHAR_MIN = %s\n", unsigned_image(image, WCHAR_MIN));
+    fprintf(out, "    WCHAR_MAX = %s\n", unsigned_image(image, WCHAR_MAX));
 #else
-    printf("    WCHAR_MIN = %s\n", signed_image(WCHAR_MIN));
-    printf("    WCHAR_MAX = %s\n", signed_image(WCHAR_MAX));
+    fprintf(out, "    WCHAR_MIN = %s\n", signed_image(image, WCHAR_MIN));
+    fprintf(out, "    WCHAR_MAX = %s\n", signed_image(image, WCHAR_MAX));
 #endif
 #endif
 
 #ifdef WINT_MIN
 #if WINT_MIN == 0
-    printf("    WINT_MIN = %s\n", unsigned_image(WINT_MIN));
-    printf("    WINT_MAX = %s\n", unsigned_image(WINT_MAX));
+    fprintf(out, "    WINT_MIN = %s\n", unsigned_image(image, WINT_MIN));
+    fprintf(out, "    WINT_MAX = %s\n", unsigned_image(image, WINT_MAX));
 #else
-    printf("    WINT_MIN = %s\n", signed_image(WINT_MIN));
-    printf("    WINT_MAX = %s\n", signed_image(WINT_MAX));
+    fprintf(out, "    WINT_MIN = %s\n", signed_image(image, WINT_MIN));
+    fprintf(out, "    WINT_MAX = %s\n", signed_image(image, WINT_MAX));
 #endif
 #endif
 
 #else
-    puts("    header_exists = false");
+    fputs("    header_exists = false\n", out);
 #endif
-    putchar('\n');
+    putc('\n', out);
 }
 
-int main(int argc, char **argv) {
-    set_formats();
+/*
+ * Bit-field layout.  The order in which bit-fields are allocated within
+ * a unit, whether a bit-field that doesn't fit in the rest of a unit
+ * straddles into the next one, the signedness of plain int bit-fields
+ * and the size of the addressable unit are all implementation-defined.
+ * They're determined by setting one field of a zeroed struct and
+ * looking at its representation.
+ */
+
+struct bitfield_order {
+    unsigned first : 1;
+    unsigned rest : 7;
+};
 
-    show_configuration(argc, argv);
-    show_predefined_macros();
-    show_limits_h();
-    show_float_h();
-    show_stdint_h();
+struct bitfield_straddle {
+    unsigned first : CHAR_BIT * sizeof (unsigned) - 4;
+    unsigned second : 8;
+};
 
+struct bitfield_plain_int {
+    int f : 2;
+};
+
+struct bitfield_int { int f : 1; };
+struct bitfield_unsigned { unsigned f : 1; };
 #ifdef STDBOOL_H_EXISTS
-    SHOW_INTEGER_TYPE(bool, bool_endianness(), 0, 0, false);
+struct bitfield_bool { bool f : 1; };
 #endif
 
-    SHOW_INTEGER_TYPE(enum small_enum, small_enum_endianness(), 0, 0, true);
-    SHOW_INTEGER_TYPE(enum small_signed_enum, small_signed_enum_endianness(), 0, 0, true);
+static const char *bitfield_allocation_order(void) {
+    struct bitfield_order s;
+    unsigned word = 0;
+    memset(&s, 0, sizeof s);
+    s.first = 1;
+    memcpy(&word, &s, sizeof s < sizeof word ? sizeof s : sizeof word);
+    if (word == 1) {
+        return "low-to-high";
+    }
+    else if (word == (UINT_MAX ^ (UINT_MAX >> 1))) {
+        return "high-to-low";
+    }
+    else {
+        return "unknown";
+    }
+} /* bitfield_allocation_order */
+
+static bool bitfields_straddle_units(void) {
+    struct bitfield_straddle s;
+    unsigned char bytes[sizeof s];
+    size_t i;
+    memset(&s, 0, sizeof s);
+    s.second = 0xff;
+    memcpy(bytes, &s, sizeof s);
+    for (i = 0; i < sizeof (unsigned) && i < sizeof s; i ++) {
+        if (bytes[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+} /* bitfields_straddle_units */
+
+static void show_bitfields(FILE *out) {
+    struct bitfield_plain_int p;
+    p.f = -1;
+
+    fputs("[bitfields]\n", out);
+    fputs("    kind = bitfield_layout\n", out);
+    fprintf(out, "    allocation_order = %s\n", bitfield_allocation_order());
+    fprintf(out, "    straddles_units = %s\n", bitfields_straddle_units() ? "true" : "false");
+    fprintf(out, "    plain_int_signedness = %s\n", p.f < 0 ? "signed" : "unsigned");
+    fprintf(out, "    int_unit_size = %d\n", (int)(CHAR_BIT * sizeof (struct bitfield_int)));
+    fprintf(out, "    int_unit_alignment = %d\n", ALIGNOF(struct bitfield_int) * CHAR_BIT);
+    fprintf(out, "    unsigned_unit_size = %d\n", (int)(CHAR_BIT * sizeof (struct bitfield_unsigned)));
+    fprintf(out, "    unsigned_unit_alignment = %d\n", ALIGNOF(struct bitfield_unsigned) * CHAR_BIT);
+#ifdef STDBOOL_H_EXISTS
+    fprintf(out, "    bool_unit_size = %d\n", (int)(CHAR_BIT * sizeof (struct bitfield_bool)));
+    fprintf(out, "    bool_unit_alignment = %d\n", ALIGNOF(struct bitfield_bool) * CHAR_BIT);
+#endif
+    putc('\n', out);
+} /* show_bitfields */
 
-    SHOW_INTEGER_TYPE(char, char_endianness(), CHAR_MIN, CHAR_MAX, false);
-#ifdef SIGNED_CHAR_EXISTS
-    SHOW_INTEGER_TYPE(signed char, signed_char_endianness(), SCHAR_MIN, SCHAR_MAX, false);
+/*
+ * Enum storage.  The size of a three-value enum with the current
+ * compiler options (short_enums is true if that's narrower than int,
+ * as with gcc's -fshort-enums), with gcc's packed attribute, and with
+ * a C23 fixed underlying type of unsigned char.
+ */
+static void show_enum_storage(FILE *out) {
+    fputs("[enum_storage]\n", out);
+    fputs("    kind = enum_storage\n", out);
+    fprintf(out, "    default_size = %d\n", (int)(CHAR_BIT * sizeof (enum small_enum)));
+    fprintf(out, "    short_enums = %s\n", sizeof (enum small_enum) < sizeof (int) ? "true" : "false");
+#ifdef __GNUC__
+    fprintf(out, "    packed_size = %d\n", (int)(CHAR_BIT * sizeof (enum packed_enum)));
+#else
+    fputs("    packed_size = unsupported\n", out);
+#endif
+#ifdef ENUM_UNDERLYING_TYPE_SUPPORTED
+    fprintf(out, "    fixed_unsigned_char_size = %d\n", (int)(CHAR_BIT * sizeof (enum fixed_enum)));
+#else
+    fputs("    fixed_unsigned_char_size = unsupported\n", out);
 #endif
-    SHOW_INTEGER_TYPE(unsigned char, unsigned_char_endianness(), 0, UCHAR_MAX, false);
+    putc('\n', out);
+} /* show_enum_storage */
+
+#ifdef ENABLE_BENCHMARKS
 
-    SHOW_INTEGER_TYPE(short, short_endianness(), SHRT_MIN, SHRT_MAX, false);
-    SHOW_INTEGER_TYPE(unsigned short, unsigned_short_endianness(), 0, USHRT_MAX, false);
+/*
+ * Measurement support.
+ *
+ * A benchmark is a function that performs an operation n times.
+ * measure() picks n so that one run takes at least BENCH_MIN_SECONDS
+ * (or uses BENCH_ITERATIONS if that's nonzero, so that runs on
+ * different machines or builds do the same amount of work), does one
+ * warmup run, then times BENCH_TRIALS runs.  The reported time is
+ * the median of the trials; the fastest trial, the BENCH_PERCENTILE
+ * percentile and the median absolute deviation are kept too, and are
+ * shown with --statistics.  All of these can be overridden with -D.
+ *
+ * Anything a benchmark computes should be stored into a volatile
+ * object, or passed to bench_escape(), so the work can't be optimized
+ * away.
+ */
 
-    SHOW_INTEGER_TYPE(int, int_endianness(), INT_MIN, INT_MAX, false);
-    SHOW_INTEGER_TYPE(unsigned, unsigned_endianness(), 0, UINT_MAX, false);
+#ifndef BENCH_MIN_SECONDS
+#define BENCH_MIN_SECONDS 0.01
+#endif
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 0
+#endif
+#ifndef BENCH_TRIALS
+#define BENCH_TRIALS 5
+#endif
+#ifndef BENCH_PERCENTILE
+#define BENCH_PERCENTILE 90
+#endif
 
-    SHOW_INTEGER_TYPE(long, long_endianness(), LONG_MIN, LONG_MAX, false);
-    SHOW_INTEGER_TYPE(unsigned long, unsigned_long_endianness(), 0, ULONG_MAX, false);
+typedef void bench_fn(void *ctx, unsigned long n);
 
-#ifdef LONG_LONG_EXISTS
-    SHOW_INTEGER_TYPE(long long, long_long_endianness(), MY_LLONG_MIN, MY_LLONG_MAX, false);
-    SHOW_INTEGER_TYPE(unsigned long long, unsigned_long_long_endianness(), 0, MY_ULLONG_MAX, false);
+/*
+ * The hardware events counted with --counters.  Cache misses are for
+ * reads; "llc" is the generic cache-misses event, which is usually the
+ * last level cache.
+ */
+enum hw_counter {
+    hc_cycles, hc_instructions, hc_l1d_misses, hc_llc_misses,
+    hc_branch_misses, hc_dtlb_misses, HW_COUNTER_COUNT
+};
+
+static const char *const hw_counter_names[HW_COUNTER_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses",
+    "branch_misses", "dtlb_misses"
+};
+
+struct measurement {
+    double ns_per_op;           /* median of the trials */
+    double min_ns;
+    double percentile_ns;
+    double mad_ns;              /* median absolute deviation */
+    double cycles_per_op;       /* negative if there's no cycle counter */
+    double per_op[HW_COUNTER_COUNT];    /* negative if not counted */
+    unsigned long iterations;
+};
+
+/*
+ * Set by --statistics, --counters and --cpu=n.
+ */
+static bool show_statistics = false;
+static bool use_counters = false;
+static int pinned_cpu = -1;
+
+/*
+ * Optimization barriers.  bench_escape(p) makes the compiler assume
+ * that *p is read, bench_clobber() that all memory is read and
+ * written, and bench_launder(x) that the variable x (which must fit
+ * in registers) is read and changed, without generating any code.
+ * Without inline assembly, bench_escape() stores the pointer into a
+ * volatile object, and bench_clobber() and bench_launder() do nothing.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#    define bench_escape(p) __asm__ __volatile__("" : : "g"(p) : "memory")
+#    define bench_clobber() __asm__ __volatile__("" : : : "memory")
+#    define bench_launder(x) __asm__ __volatile__("" : "+r"(x))
+#else
+static const void *volatile bench_escape_sink;
+#    define bench_escape(p) ((void)(bench_escape_sink = (p)))
+#    define bench_clobber() ((void)0)
+#    define bench_launder(x) ((void)0)
 #endif
 
-    SHOW_FLOATING_TYPE(float,       FLT_MANT_DIG,  FLT_MIN_EXP,  FLT_MAX_EXP,
-                                    f_one, f_minus_sixteen, f_one_million, false);
-    SHOW_FLOATING_TYPE(double,      DBL_MANT_DIG,  DBL_MIN_EXP,  DBL_MAX_EXP,
-                                    d_one, d_minus_sixteen, d_one_million, false);
-#ifdef LONG_DOUBLE_EXISTS
-    SHOW_FLOATING_TYPE(long double, LDBL_MANT_DIG, LDBL_MIN_EXP, LDBL_MAX_EXP,
-                                    ld_one, ld_minus_sixteen, ld_one_million, false);
+/*
+ * Returns the current time in seconds from an arbitrary origin,
+ * using the best clock available.
+ */
+static double bench_now(void) {
+#if defined(CLOCK_GETTIME_EXISTS) && defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#elif defined(TIME_UTC)
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+} /* bench_now */
+
+#ifdef CYCLE_COUNTER_EXISTS
+static uint_least64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (uint_least64_t)hi << 32 | lo;
+#else
+    uint64_t value;
+    __asm__ __volatile__("isb\n\tmrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#endif
+} /* bench_cycles */
 #endif
 
-    SHOW_INTEGER_TYPE(ptrdiff_t, ptrdiff_t_endianness(), MY_PTRDIFF_MIN, MY_PTRDIFF_MAX, true);
-    SHOW_INTEGER_TYPE(size_t, size_t_endianness(), 0, MY_SIZE_MAX, true);
-    SHOW_INTEGER_TYPE(wchar_t, wchar_t_endianness(), MY_WCHAR_MIN, MY_WCHAR_MAX, true);
+/*
+ * Hardware counters are opened separately rather than as a group, so
+ * that events the CPU or kernel doesn't support (common in virtual
+ * machines) are simply left out, and so that the kernel can multiplex
+ * them if there are more events than counters; counts are scaled by
+ * the fraction of the time each was actually counting.  Only user
+ * mode is counted, which is allowed with the default
+ * perf_event_paranoid setting.  Anything that fails leaves the
+ * measurement with wall-clock times only.
+ */
+#ifdef PERF_EVENT_EXISTS
+static int open_hw_counter(enum hw_counter c) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (c) {
+        case hc_cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case hc_instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case hc_llc_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case hc_branch_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case hc_l1d_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D |
+                          PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                          PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+            break;
+        case hc_dtlb_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                          PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                          PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+            break;
+        default:
+            return -1;
+    }
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+} /* open_hw_counter */
+#endif
 
-    if ((time_t)1 / 2 == 0) {
-        SHOW_INTEGER_TYPE(time_t, time_t_endianness(), 0, 0, true);
+/*
+ * Runs fn(ctx, n) once with the hardware counters enabled and sets
+ * m->per_op[] to the count per operation, or to -1 for each event
+ * that couldn't be counted.
+ */
+static void count_hw_events(bench_fn *fn, void *ctx, unsigned long n, struct measurement *m) {
+#ifdef PERF_EVENT_EXISTS
+    int fds[HW_COUNTER_COUNT];
+    int c;
+
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        fds[c] = open_hw_counter((enum hw_counter)c);
+        if (fds[c] >= 0) {
+            ioctl(fds[c], PERF_EVENT_IOC_RESET, 0);
+        }
     }
-    else {
-        static const time_t dummy = 0.0;
-        SHOW_FLOATING_TYPE(time_t, 0, 0, 0, dummy, dummy, dummy, true);
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        if (fds[c] >= 0) {
+            ioctl(fds[c], PERF_EVENT_IOC_ENABLE, 0);
+        }
     }
-
-    if ((clock_t)1 / 2 == 0) {
-        SHOW_INTEGER_TYPE(clock_t, clock_t_endianness(), 0, 0, true);
+    bench_clobber();
+    fn(ctx, n);
+    bench_clobber();
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        if (fds[c] >= 0) {
+            ioctl(fds[c], PERF_EVENT_IOC_DISABLE, 0);
+        }
     }
-    else {
-        static const clock_t dummy = 0.0;
-        SHOW_FLOATING_TYPE(clock_t, 0, 0, 0, dummy, dummy, dummy, true);
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        uint64_t values[3];     /* count, time enabled, time running */
+        m->per_op[c] = -1.0;
+        if (fds[c] < 0) {
+            continue;
+        }
+        if (read(fds[c], values, sizeof values) == (ssize_t)sizeof values && values[2] > 0) {
+            m->per_op[c] = (double)values[0] * ((double)values[1] / (double)values[2]) / (double)n;
+        }
+        close(fds[c]);
     }
+#else
+    int c;
+    (void)fn;
+    (void)ctx;
+    (void)n;
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        m->per_op[c] = -1.0;
+    }
+#endif
+} /* count_hw_events */
 
-    SHOW_RAW_TYPE(struct tm);
-
-    SHOW_RAW_TYPE(void*);
-    SHOW_RAW_TYPE(char*);
-    SHOW_RAW_TYPE(int*);
-    SHOW_RAW_TYPE(double*);
-    SHOW_RAW_TYPE(struct{int x;}*);
-    SHOW_RAW_TYPE_WITH_NAME(simple_func_ptr, "void(*)(void)");
-    SHOW_RAW_TYPE_WITH_NAME(complex_func_ptr, "double(*)(int*,char**)");
-
-    check_size("    integer", integer_sizes, 8);
-    check_size("    integer", integer_sizes, 16);
-    check_size("    integer", integer_sizes, 32);
-    check_size("    integer", integer_sizes, 64);
-
-    if (huge_integer) {
-        puts("        {");
-        puts("            \"node_kind\" : \"comment\",");
-        printf("            \"comment\" : \"There is at least one integer type bigger than %d bits\"\n",
-               MAX_SIZE);
-        puts("        },");
+/*
+ * Returns the number of the hardware events that can be counted.
+ */
+static int available_hw_counters(void) {
+    int result = 0;
+#ifdef PERF_EVENT_EXISTS
+    int c;
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        const int fd = open_hw_counter((enum hw_counter)c);
+        if (fd >= 0) {
+            result ++;
+            close(fd);
+        }
     }
+#endif
+    return result;
+}
 
-    check_size("    floating-point", float_sizes, 32);
-    check_size("    floating-point", float_sizes, 64);
-    check_size("    floating-point", float_sizes, 128);
+static int compare_doubles(const void *a, const void *b) {
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
 
-    if (huge_float) {
-        puts("        {");
-        puts("            \"node_kind\" : \"comment\",");
-        printf("           \"comment\" : \"There is at least one float type bigger than %d bits\"\n",
-               MAX_SIZE);
-        puts("        },");
+/*
+ * Sorts values[0..count-1] and returns the median.
+ */
+static double bench_median(double *values, size_t count) {
+    qsort(values, count, sizeof *values, compare_doubles);
+    return count % 2 == 1 ? values[count / 2]
+                          : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+static void measure(bench_fn *fn, void *ctx, struct measurement *m) {
+    unsigned long n = BENCH_ITERATIONS;
+    double times[BENCH_TRIALS];
+    double deviations[BENCH_TRIALS];
+#ifdef CYCLE_COUNTER_EXISTS
+    double cycles[BENCH_TRIALS];
+#endif
+    size_t rank;
+    int trial;
+
+    if (n == 0) {
+        n = 1;
+        for (;;) {
+            const double start = bench_now();
+            double elapsed;
+            fn(ctx, n);
+            bench_clobber();
+            elapsed = bench_now() - start;
+            if (elapsed >= BENCH_MIN_SECONDS || n >= ULONG_MAX / 2) {
+                break;
+            }
+            n *= 2;
+        }
+    }
+
+    /* Warmup: caches, branch predictors and CPU frequency settle */
+    fn(ctx, n);
+    bench_clobber();
+
+    for (trial = 0; trial < BENCH_TRIALS; trial ++) {
+        double start;
+#ifdef CYCLE_COUNTER_EXISTS
+        uint_least64_t start_cycles;
+#endif
+        bench_clobber();
+        start = bench_now();
+#ifdef CYCLE_COUNTER_EXISTS
+        start_cycles = bench_cycles();
+#endif
+        fn(ctx, n);
+        bench_clobber();
+#ifdef CYCLE_COUNTER_EXISTS
+        cycles[trial] = (double)(bench_cycles() - start_cycles) / (double)n;
+#endif
+        times[trial] = (bench_now() - start) * 1.0e9 / (double)n;
+    }
+
+    m->iterations = n;
+    m->ns_per_op = bench_median(times, BENCH_TRIALS);
+    m->min_ns = times[0];
+    /* Nearest-rank percentile */
+    rank = (BENCH_PERCENTILE * BENCH_TRIALS + 99) / 100;
+    m->percentile_ns = times[rank > 0 ? rank - 1 : 0];
+    for (trial = 0; trial < BENCH_TRIALS; trial ++) {
+        deviations[trial] = fabs(times[trial] - m->ns_per_op);
+    }
+    m->mad_ns = bench_median(deviations, BENCH_TRIALS);
+#ifdef CYCLE_COUNTER_EXISTS
+    m->cycles_per_op = bench_median(cycles, BENCH_TRIALS);
+#else
+    m->cycles_per_op = -1.0;
+#endif
+
+    /* Counting is done in a separate run so it can't disturb the times */
+    if (use_counters) {
+        count_hw_events(fn, ctx, n, m);
+    }
+    else {
+        int c;
+        for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+            m->per_op[c] = -1.0;
+        }
+    }
+} /* measure */
+
+/*
+ * Shows the time per operation as "<key>_ns".  With --statistics,
+ * also shows the spread of the trials and, if there's a cycle
+ * counter, the counter ticks per operation.  With --counters, also
+ * shows each hardware event counted, per operation, and the
+ * instructions per cycle.
+ */
+static void show_ns(FILE *out, const char *key, const struct measurement *m) {
+    int c;
+
+    fprintf(out, "    %s_ns = %.3f\n", key, m->ns_per_op);
+    if (show_statistics) {
+        fprintf(out, "    %s_ns.min = %.3f\n", key, m->min_ns);
+        fprintf(out, "    %s_ns.p%d = %.3f\n", key, BENCH_PERCENTILE, m->percentile_ns);
+        fprintf(out, "    %s_ns.mad = %.3f\n", key, m->mad_ns);
+        if (m->cycles_per_op >= 0.0) {
+            fprintf(out, "    %s_cycles = %.3f\n", key, m->cycles_per_op);
+        }
+    }
+    for (c = 0; c < HW_COUNTER_COUNT; c ++) {
+        if (m->per_op[c] >= 0.0) {
+            fprintf(out, "    %s.%s = %.3f\n", key, hw_counter_names[c], m->per_op[c]);
+        }
+    }
+    if (m->per_op[hc_cycles] > 0.0 && m->per_op[hc_instructions] >= 0.0) {
+        fprintf(out, "    %s.ipc = %.2f\n", key, m->per_op[hc_instructions] / m->per_op[hc_cycles]);
+    }
+} /* show_ns */
+
+/*
+ * A small, fast pseudo-random generator (splitmix64) for building
+ * benchmark inputs.  The sequence is the same on every run.
+ */
+static uint_least64_t bench_random(uint_least64_t *state) {
+    uint_least64_t z = (*state += 0x9e3779b97f4a7c15U) & 0xffffffffffffffffU;
+    z = ((z ^ (z >> 30)) * 0xbf58476d1ce4e5b9U) & 0xffffffffffffffffU;
+    z = ((z ^ (z >> 27)) * 0x94d049bb133111ebU) & 0xffffffffffffffffU;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Shows a throughput derived from a measurement, in millions of
+ * units per second, as "<key>_<unit>_per_s".  units_per_op is the
+ * number of units (values, bytes, ...) handled by one operation.
+ */
+static void show_rate(FILE *out, const char *key, const char *unit,
+                      const struct measurement *m, double units_per_op)
+{
+    fprintf(out, "    %s_%s_per_s = %.3f\n", key, unit, units_per_op * 1.0e3 / m->ns_per_op);
+}
+
+/*
+ * Numeric text conversion.  Each type is formatted with snprintf()
+ * and parsed back with the matching strto*() function, over two
+ * distributions: "small" values (a few digits, typical of counters
+ * and fields in logs) and "full" values spread over the whole range
+ * of the type (for floating types, printed with enough digits to
+ * round-trip).
+ */
+
+#define TEXT_VALUES 4096  /* must be a power of 2 */
+#define TEXT_SLOT 64
+
+struct text_ctx {
+    bool full;
+    longest_signed s[TEXT_VALUES];
+    longest_unsigned u[TEXT_VALUES];
+    long double f[TEXT_VALUES];
+    char text[TEXT_VALUES][TEXT_SLOT];
+    int precision;
+    volatile longest_unsigned sink;
+    volatile long double fsink;
+};
+
+struct text_conversion {
+    const char *type_name;
+    const char *format;
+    const char *parse_name;
+    void (*prepare)(struct text_ctx *c);
+    bench_fn *format_bench;
+    bench_fn *parse_bench;
+};
+
+#define DEFINE_INTEGER_TEXT_BENCH(name, type, values, format, parse)   \
+static void prepare_text_##name(struct text_ctx *c) {                  \
+    int i;                                                              \
+    for (i = 0; i < TEXT_VALUES; i ++) {                                \
+        sprintf(c->text[i], format, (type)c->values[i]);                \
+    }                                                                   \
+}                                                                       \
+static void bench_format_##name(void *ctx, unsigned long n) {          \
+    struct text_ctx *const c = ctx;                                     \
+    char buf[TEXT_SLOT];                                                \
+    longest_unsigned total = 0;                                         \
+    unsigned long i;                                                    \
+    for (i = 0; i < n; i ++) {                                          \
+        total += snprintf(buf, sizeof buf, format,                      \
+                          (type)c->values[i % TEXT_VALUES]);            \
+    }                                                                   \
+    c->sink = total + (unsigned char)buf[0];                            \
+}                                                                       \
+static void bench_parse_##name(void *ctx, unsigned long n) {           \
+    struct text_ctx *const c = ctx;                                     \
+    longest_unsigned total = 0;                                         \
+    unsigned long i;                                                    \
+    for (i = 0; i < n; i ++) {                                          \
+        char *end;                                                      \
+        total += (longest_unsigned)parse(c->text[i % TEXT_VALUES], &end, 10); \
+    }                                                                   \
+    c->sink = total;                                                    \
+}                                                                       \
+static const struct text_conversion text_conversion_##name = {          \
+    #type, format, #parse,                                              \
+    prepare_text_##name, bench_format_##name, bench_parse_##name        \
+};
+
+#define DEFINE_FLOATING_TEXT_BENCH(name, type, format, parse)          \
+static void prepare_text_##name(struct text_ctx *c) {                  \
+    int i;                                                              \
+    for (i = 0; i < TEXT_VALUES; i ++) {                                \
+        sprintf(c->text[i], format, c->precision, (type)c->f[i]);       \
+    }                                                                   \
+}                                                                       \
+static void bench_format_##name(void *ctx, unsigned long n) {          \
+    struct text_ctx *const c = ctx;                                     \
+    char buf[TEXT_SLOT];                                                \
+    longest_unsigned total = 0;                                         \
+    unsigned long i;                                                    \
+    for (i = 0; i < n; i ++) {                                          \
+        total += snprintf(buf, sizeof buf, format, c->precision,        \
+                          (type)c->f[i % TEXT_VALUES]);                 \
+    }                                                                   \
+    c->sink = total + (unsigned char)buf[0];                            \
+}                                                                       \
+static void bench_parse_##name(void *ctx, unsigned long n) {           \
+    struct text_ctx *const c = ctx;                                     \
+    type total = 0;                                                     \
+    unsigned long i;                                                    \
+    for (i = 0; i < n; i ++) {                                          \
+        char *end;                                                      \
+        total += parse(c->text[i % TEXT_VALUES], &end);                 \
+    }                                                                   \
+    c->fsink = total;                                                   \
+}                                                                       \
+static const struct text_conversion text_conversion_##name = {          \
+    #type, format, #parse,                                              \
+    prepare_text_##name, bench_format_##name, bench_parse_##name        \
+};
+
+#ifdef SIGNED_CHAR_EXISTS
+DEFINE_INTEGER_TEXT_BENCH(signed_char,    signed char,        s, "%hhd", strtol)
+#endif
+DEFINE_INTEGER_TEXT_BENCH(unsigned_char,  unsigned char,      u, "%hhu", strtoul)
+DEFINE_INTEGER_TEXT_BENCH(short,          short,              s, "%hd",  strtol)
+DEFINE_INTEGER_TEXT_BENCH(unsigned_short, unsigned short,     u, "%hu",  strtoul)
+DEFINE_INTEGER_TEXT_BENCH(int,            int,                s, "%d",   strtol)
+DEFINE_INTEGER_TEXT_BENCH(unsigned,       unsigned,           u, "%u",   strtoul)
+DEFINE_INTEGER_TEXT_BENCH(long,           long,               s, "%ld",  strtol)
+DEFINE_INTEGER_TEXT_BENCH(unsigned_long,  unsigned long,      u, "%lu",  strtoul)
+#ifdef LONG_LONG_EXISTS
+DEFINE_INTEGER_TEXT_BENCH(long_long,      long long,          s, "%lld", strtoll)
+DEFINE_INTEGER_TEXT_BENCH(unsigned_long_long, unsigned long long, u, "%llu", strtoull)
+#endif
+#ifdef INT8_MAX
+DEFINE_INTEGER_TEXT_BENCH(int8_t,         int8_t,             s, "%" PRId8, strtoimax)
+#endif
+#ifdef UINT8_MAX
+DEFINE_INTEGER_TEXT_BENCH(uint8_t,        uint8_t,            u, "%" PRIu8, strtoumax)
+#endif
+#ifdef INT16_MAX
+DEFINE_INTEGER_TEXT_BENCH(int16_t,        int16_t,            s, "%" PRId16, strtoimax)
+#endif
+#ifdef UINT16_MAX
+DEFINE_INTEGER_TEXT_BENCH(uint16_t,       uint16_t,           u, "%" PRIu16, strtoumax)
+#endif
+#ifdef INT32_MAX
+DEFINE_INTEGER_TEXT_BENCH(int32_t,        int32_t,            s, "%" PRId32, strtoimax)
+#endif
+#ifdef UINT32_MAX
+DEFINE_INTEGER_TEXT_BENCH(uint32_t,       uint32_t,           u, "%" PRIu32, strtoumax)
+#endif
+#ifdef INT64_MAX
+DEFINE_INTEGER_TEXT_BENCH(int64_t,        int64_t,            s, "%" PRId64, strtoimax)
+#endif
+#ifdef UINT64_MAX
+DEFINE_INTEGER_TEXT_BENCH(uint64_t,       uint64_t,           u, "%" PRIu64, strtoumax)
+#endif
+DEFINE_INTEGER_TEXT_BENCH(int_least8_t,   int_least8_t,       s, "%" PRIdLEAST8, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_least8_t,  uint_least8_t,      u, "%" PRIuLEAST8, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_least16_t,  int_least16_t,      s, "%" PRIdLEAST16, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_least16_t, uint_least16_t,     u, "%" PRIuLEAST16, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_least32_t,  int_least32_t,      s, "%" PRIdLEAST32, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_least32_t, uint_least32_t,     u, "%" PRIuLEAST32, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_least64_t,  int_least64_t,      s, "%" PRIdLEAST64, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_least64_t, uint_least64_t,     u, "%" PRIuLEAST64, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_fast8_t,    int_fast8_t,        s, "%" PRIdFAST8, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_fast8_t,   uint_fast8_t,       u, "%" PRIuFAST8, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_fast16_t,   int_fast16_t,       s, "%" PRIdFAST16, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_fast16_t,  uint_fast16_t,      u, "%" PRIuFAST16, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_fast32_t,   int_fast32_t,       s, "%" PRIdFAST32, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_fast32_t,  uint_fast32_t,      u, "%" PRIuFAST32, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(int_fast64_t,   int_fast64_t,       s, "%" PRIdFAST64, strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uint_fast64_t,  uint_fast64_t,      u, "%" PRIuFAST64, strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(intmax_t,       intmax_t,           s, "%jd",  strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(uintmax_t,      uintmax_t,          u, "%ju",  strtoumax)
+DEFINE_INTEGER_TEXT_BENCH(ptrdiff_t,      ptrdiff_t,          s, "%td",  strtoimax)
+DEFINE_INTEGER_TEXT_BENCH(size_t,         size_t,             u, "%zu",  strtoumax)
+
+DEFINE_FLOATING_TEXT_BENCH(float,         float,              "%.*g",  strtof)
+DEFINE_FLOATING_TEXT_BENCH(double,        double,             "%.*g",  strtod)
+#ifdef LONG_DOUBLE_EXISTS
+DEFINE_FLOATING_TEXT_BENCH(long_double,   long double,        "%.*Lg", strtold)
+#endif
+
+/*
+ * The integer values are generated as longest_signed/longest_unsigned
+ * and converted to each type, so they're only full-range for the widest
+ * types.  That's why each integer type also has its min and max here.
+ */
+struct integer_text_type {
+    const struct text_conversion *conv;
+    longest_signed min;
+    longest_unsigned max;
+};
+
+static const struct integer_text_type integer_text_types[] = {
+#ifdef SIGNED_CHAR_EXISTS
+    { &text_conversion_signed_char, SCHAR_MIN, SCHAR_MAX },
+#endif
+    { &text_conversion_unsigned_char, 0, UCHAR_MAX },
+    { &text_conversion_short, SHRT_MIN, SHRT_MAX },
+    { &text_conversion_unsigned_short, 0, USHRT_MAX },
+    { &text_conversion_int, INT_MIN, INT_MAX },
+    { &text_conversion_unsigned, 0, UINT_MAX },
+    { &text_conversion_long, LONG_MIN, LONG_MAX },
+    { &text_conversion_unsigned_long, 0, ULONG_MAX },
+#ifdef LONG_LONG_EXISTS
+    { &text_conversion_long_long, MY_LLONG_MIN, MY_LLONG_MAX },
+    { &text_conversion_unsigned_long_long, 0, MY_ULLONG_MAX },
+#endif
+#ifdef INT8_MAX
+    { &text_conversion_int8_t, INT8_MIN, INT8_MAX },
+#endif
+#ifdef UINT8_MAX
+    { &text_conversion_uint8_t, 0, UINT8_MAX },
+#endif
+#ifdef INT16_MAX
+    { &text_conversion_int16_t, INT16_MIN, INT16_MAX },
+#endif
+#ifdef UINT16_MAX
+    { &text_conversion_uint16_t, 0, UINT16_MAX },
+#endif
+#ifdef INT32_MAX
+    { &text_conversion_int32_t, INT32_MIN, INT32_MAX },
+#endif
+#ifdef UINT32_MAX
+    { &text_conversion_uint32_t, 0, UINT32_MAX },
+#endif
+#ifdef INT64_MAX
+    { &text_conversion_int64_t, INT64_MIN, INT64_MAX },
+#endif
+#ifdef UINT64_MAX
+    { &text_conversion_uint64_t, 0, UINT64_MAX },
+#endif
+    { &text_conversion_int_least8_t, INT_LEAST8_MIN, INT_LEAST8_MAX },
+    { &text_conversion_uint_least8_t, 0, UINT_LEAST8_MAX },
+    { &text_conversion_int_least16_t, INT_LEAST16_MIN, INT_LEAST16_MAX },
+    { &text_conversion_uint_least16_t, 0, UINT_LEAST16_MAX },
+    { &text_conversion_int_least32_t, INT_LEAST32_MIN, INT_LEAST32_MAX },
+    { &text_conversion_uint_least32_t, 0, UINT_LEAST32_MAX },
+    { &text_conversion_int_least64_t, INT_LEAST64_MIN, INT_LEAST64_MAX },
+    { &text_conversion_uint_least64_t, 0, UINT_LEAST64_MAX },
+    { &text_conversion_int_fast8_t, INT_FAST8_MIN, INT_FAST8_MAX },
+    { &text_conversion_uint_fast8_t, 0, UINT_FAST8_MAX },
+    { &text_conversion_int_fast16_t, INT_FAST16_MIN, INT_FAST16_MAX },
+    { &text_conversion_uint_fast16_t, 0, UINT_FAST16_MAX },
+    { &text_conversion_int_fast32_t, INT_FAST32_MIN, INT_FAST32_MAX },
+    { &text_conversion_uint_fast32_t, 0, UINT_FAST32_MAX },
+    { &text_conversion_int_fast64_t, INT_FAST64_MIN, INT_FAST64_MAX },
+    { &text_conversion_uint_fast64_t, 0, UINT_FAST64_MAX },
+    { &text_conversion_intmax_t, INTMAX_MIN, INTMAX_MAX },
+    { &text_conversion_uintmax_t, 0, UINTMAX_MAX },
+    { &text_conversion_ptrdiff_t, PTRDIFF_MIN, PTRDIFF_MAX },
+    { &text_conversion_size_t, 0, SIZE_MAX },
+};
+
+struct floating_text_type {
+    const struct text_conversion *conv;
+    int full_precision;
+};
+
+#ifdef FLT_DECIMAL_DIG
+#define MY_FLT_DECIMAL_DIG FLT_DECIMAL_DIG
+#else
+#define MY_FLT_DECIMAL_DIG 9
+#endif
+#ifdef DBL_DECIMAL_DIG
+#define MY_DBL_DECIMAL_DIG DBL_DECIMAL_DIG
+#else
+#define MY_DBL_DECIMAL_DIG 17
+#endif
+#ifdef LDBL_DECIMAL_DIG
+#define MY_LDBL_DECIMAL_DIG LDBL_DECIMAL_DIG
+#else
+#define MY_LDBL_DECIMAL_DIG 36
+#endif
+
+static const struct floating_text_type floating_text_types[] = {
+    { &text_conversion_float, MY_FLT_DECIMAL_DIG },
+    { &text_conversion_double, MY_DBL_DECIMAL_DIG },
+#ifdef LONG_DOUBLE_EXISTS
+    { &text_conversion_long_double, MY_LDBL_DECIMAL_DIG },
+#endif
+};
+
+static void fill_integer_text_values(struct text_ctx *c, longest_signed min, longest_unsigned max) {
+    uint_least64_t state = 27;
+    int i;
+    for (i = 0; i < TEXT_VALUES; i ++) {
+        const longest_unsigned r = (longest_unsigned)bench_random(&state);
+        if (! c->full) {
+            c->u[i] = r % 100;
+            c->s[i] = min < 0 ? (longest_signed)(r % 199) - 99 : (longest_signed)(r % 100);
+        }
+        else if (min < 0) {
+            /* uniform over [min, max]; max is 2**n-1, min is -max-1 */
+            const longest_signed magnitude = (longest_signed)(r & max);
+            c->s[i] = (r >> 63) & 1 ? -magnitude - 1 : magnitude;
+        }
+        else {
+            c->u[i] = r & max;
+        }
+    }
+} /* fill_integer_text_values */
+
+static void fill_floating_text_values(struct text_ctx *c) {
+    uint_least64_t state = 27;
+    int i;
+    for (i = 0; i < TEXT_VALUES; i ++) {
+        const uint_least64_t r1 = bench_random(&state);
+        const uint_least64_t r2 = bench_random(&state);
+        if (! c->full) {
+            /* e.g. 1234.75 */
+            c->f[i] = (long double)(r1 % 400000) / 4.0L;
+        }
+        else {
+            /* about 106 random bits of mantissa, exponent in [1e-20, 1e20] */
+            long double mantissa = ((long double)(r1 >> 11) + (long double)(r2 >> 11) / 9007199254740992.0L)
+                                   / 9007199254740992.0L;
+            int exponent = (int)(r2 % 41) - 20;
+            long double scale = 1.0L;
+            int e;
+            for (e = 0; e < (exponent < 0 ? -exponent : exponent); e ++) {
+                scale *= 10.0L;
+            }
+            c->f[i] = exponent < 0 ? mantissa / scale : mantissa * scale;
+        }
+    }
+} /* fill_floating_text_values */
+
+static void show_text_conversion_rates(FILE *out, const struct text_conversion *conv, struct text_ctx *c) {
+    static const char *const distribution[] = { "small", "full" };
+    struct measurement m;
+    char name[NAME_SIZE];
+    char key[KEY_SIZE];
+
+    conv->prepare(c);
+    measure(conv->format_bench, c, &m);
+    snprintf(key, sizeof key, "%s.snprintf.%s", space_to_hyphen(name, conv->type_name), distribution[c->full]);
+    show_rate(out, key, "mvalues", &m, 1.0);
+    measure(conv->parse_bench, c, &m);
+    snprintf(key, sizeof key, "%s.%s.%s", space_to_hyphen(name, conv->type_name), conv->parse_name, distribution[c->full]);
+    show_rate(out, key, "mvalues", &m, 1.0);
+}
+
+static void show_text_conversion(FILE *out) {
+    struct text_ctx *const c = malloc(sizeof *c);
+    char name[NAME_SIZE];
+    size_t i;
+    int d;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[text_conversion]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (i = 0; i < sizeof integer_text_types / sizeof integer_text_types[0]; i ++) {
+        const struct integer_text_type *const t = &integer_text_types[i];
+        fprintf(out, "    %s.format = \"%s\"\n", space_to_hyphen(name, t->conv->type_name), t->conv->format);
+        for (d = 0; d < 2; d ++) {
+            c->full = d;
+            fill_integer_text_values(c, t->min, t->max);
+            show_text_conversion_rates(out, t->conv, c);
+        }
+    }
+    for (i = 0; i < sizeof floating_text_types / sizeof floating_text_types[0]; i ++) {
+        const struct floating_text_type *const t = &floating_text_types[i];
+        fprintf(out, "    %s.format = \"%s\"\n", space_to_hyphen(name, t->conv->type_name), t->conv->format);
+        fprintf(out, "    %s.full_precision = %d\n", space_to_hyphen(name, t->conv->type_name), t->full_precision);
+        for (d = 0; d < 2; d ++) {
+            c->full = d;
+            c->precision = c->full ? t->full_precision : 6;
+            fill_floating_text_values(c);
+            show_text_conversion_rates(out, t->conv, c);
+        }
+    }
+    putc('\n', out);
+    free(c);
+} /* show_text_conversion */
+
+/*
+ * Integer division.  For each integer type, "/" and "%" are timed
+ * with a divisor known only at run time ("variable"), a constant
+ * divisor the compiler can strength-reduce ("constant", 7), and a
+ * constant power of two ("power_of_2", 8).  Latency is measured with
+ * a chain of dependent operations, throughput over independent
+ * operations on an array of dividends.  Arithmetic on types narrower
+ * than int is done in int after the usual promotions, and that's
+ * what's measured.
+ */
+
+#define DIVISION_VALUES 1024  /* must be a power of 2 */
+
+struct division_ctx {
+    volatile longest_signed divisor;
+    volatile longest_signed addend;
+    longest_unsigned dividends[DIVISION_VALUES];
+    volatile longest_unsigned sink;
+};
+
+#define DEFINE_DIVISION_KERNELS(name, type, op, opname, kind, divisor_expr) \
+static void bench_##opname##_##kind##_latency_##name(void *ctx, unsigned long n) { \
+    struct division_ctx *const c = ctx;                                     \
+    const type d = (type)c->divisor;                                        \
+    const type addend = (type)c->addend;                                    \
+    type x = (type)c->dividends[0];                                         \
+    unsigned long i;                                                        \
+    (void)d;                                                                \
+    for (i = 0; i < n; i ++) {                                              \
+        x = (type)(x op (divisor_expr) + addend);                           \
+    }                                                                       \
+    c->sink = (longest_unsigned)x;                                          \
+}                                                                           \
+static void bench_##opname##_##kind##_throughput_##name(void *ctx, unsigned long n) { \
+    struct division_ctx *const c = ctx;                                     \
+    const type d = (type)c->divisor;                                        \
+    type values[DIVISION_VALUES];                                           \
+    longest_unsigned total = 0;                                             \
+    unsigned long i;                                                        \
+    (void)d;                                                                \
+    for (i = 0; i < DIVISION_VALUES; i ++) {                                \
+        values[i] = (type)c->dividends[i];                                  \
+    }                                                                       \
+    for (i = 0; i < n; i ++) {                                              \
+        total += (longest_unsigned)(type)(values[i % DIVISION_VALUES] op (divisor_expr)); \
+    }                                                                       \
+    c->sink = total;                                                        \
+}
+
+#define DEFINE_DIVISION_BENCH(name, type)                                   \
+    DEFINE_DIVISION_KERNELS(name, type, /, div, variable, d)                \
+    DEFINE_DIVISION_KERNELS(name, type, /, div, constant, 7)                \
+    DEFINE_DIVISION_KERNELS(name, type, /, div, power_of_2, 8)              \
+    DEFINE_DIVISION_KERNELS(name, type, %, mod, variable, d)                \
+    DEFINE_DIVISION_KERNELS(name, type, %, mod, constant, 7)                \
+    DEFINE_DIVISION_KERNELS(name, type, %, mod, power_of_2, 8)              \
+    static bench_fn *const division_benches_##name[] = {                    \
+        bench_div_variable_latency_##name,   bench_div_variable_throughput_##name,   \
+        bench_div_constant_latency_##name,   bench_div_constant_throughput_##name,   \
+        bench_div_power_of_2_latency_##name, bench_div_power_of_2_throughput_##name, \
+        bench_mod_variable_latency_##name,   bench_mod_variable_throughput_##name,   \
+        bench_mod_constant_latency_##name,   bench_mod_constant_throughput_##name,   \
+        bench_mod_power_of_2_latency_##name, bench_mod_power_of_2_throughput_##name  \
+    };
+
+#ifdef SIGNED_CHAR_EXISTS
+DEFINE_DIVISION_BENCH(signed_char, signed char)
+#endif
+DEFINE_DIVISION_BENCH(unsigned_char, unsigned char)
+DEFINE_DIVISION_BENCH(short, short)
+DEFINE_DIVISION_BENCH(unsigned_short, unsigned short)
+DEFINE_DIVISION_BENCH(int, int)
+DEFINE_DIVISION_BENCH(unsigned, unsigned)
+DEFINE_DIVISION_BENCH(long, long)
+DEFINE_DIVISION_BENCH(unsigned_long, unsigned long)
+#ifdef LONG_LONG_EXISTS
+DEFINE_DIVISION_BENCH(long_long, long long)
+DEFINE_DIVISION_BENCH(unsigned_long_long, unsigned long long)
+#endif
+
+struct division_type {
+    const char *type_name;
+    bench_fn *const *benches;
+    longest_unsigned max;
+};
+
+static const struct division_type division_types[] = {
+#ifdef SIGNED_CHAR_EXISTS
+    { "signed char",        division_benches_signed_char,        SCHAR_MAX },
+#endif
+    { "unsigned char",      division_benches_unsigned_char,      UCHAR_MAX },
+    { "short",              division_benches_short,              SHRT_MAX },
+    { "unsigned short",     division_benches_unsigned_short,     USHRT_MAX },
+    { "int",                division_benches_int,                INT_MAX },
+    { "unsigned",           division_benches_unsigned,           UINT_MAX },
+    { "long",               division_benches_long,               LONG_MAX },
+    { "unsigned long",      division_benches_unsigned_long,      ULONG_MAX },
+#ifdef LONG_LONG_EXISTS
+    { "long long",          division_benches_long_long,          MY_LLONG_MAX },
+    { "unsigned long long", division_benches_unsigned_long_long, MY_ULLONG_MAX },
+#endif
+};
+
+static void show_integer_division(FILE *out) {
+    static const char *const ops[] = { "div", "mod" };
+    static const char *const kinds[] = { "variable", "constant", "power_of_2" };
+    struct division_ctx *const c = malloc(sizeof *c);
+    size_t t;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[integer_division]\n", out);
+    fputs("    kind = measurement\n", out);
+    c->divisor = 7;
+    for (t = 0; t < sizeof division_types / sizeof division_types[0]; t ++) {
+        const struct division_type *const dt = &division_types[t];
+        uint_least64_t state = 28;
+        int i;
+
+        /*
+         * Dividends are nonnegative and use the whole range of the type;
+         * the latency chains add max/2 after each step to stay there.
+         */
+        for (i = 0; i < DIVISION_VALUES; i ++) {
+            c->dividends[i] = (longest_unsigned)bench_random(&state) % dt->max + 1;
+        }
+        c->addend = (longest_signed)(dt->max / 2);
+
+        for (i = 0; i < 6; i ++) {
+            struct measurement m;
+            char name[NAME_SIZE];
+            char key[KEY_SIZE];
+            snprintf(key, sizeof key, "%s.%s.%s.latency", space_to_hyphen(name, dt->type_name), ops[i / 3], kinds[i % 3]);
+            measure(dt->benches[2 * i], c, &m);
+            show_ns(out, key, &m);
+            snprintf(key, sizeof key, "%s.%s.%s.throughput", space_to_hyphen(name, dt->type_name), ops[i / 3], kinds[i % 3]);
+            measure(dt->benches[2 * i + 1], c, &m);
+            show_rate(out, key, "mops", &m, 1.0);
+        }
+    }
+    putc('\n', out);
+    free(c);
+} /* show_integer_division */
+
+/*
+ * Floating-point arithmetic.  Each operation is timed as a chain of
+ * dependent operations, so this is latency, which is what a scalar
+ * accumulator sees.  add and mul alternate with the inverse operation
+ * (x + y - y, x * y * (1/y)) so the chain stays in range; sqrt is
+ * sqrt(x) + 1.5, which converges to a fixed point away from 1.
+ * A type whose add/mul/div are on average more than 10 times slower
+ * than double's is reported as emulated; on most such systems every
+ * operation is a call to a software floating-point routine.
+ */
+
+#if defined(__GNUC__) && defined(__SIZEOF_FLOAT128__)
+#define FLOAT128_EXISTS
+__extension__ typedef __float128 float128;
+#endif
+
+#define EMULATED_SLOWDOWN 10.0
+
+struct floating_arith_ctx {
+    volatile long double start;
+    volatile long double y;
+    volatile long double y_inverse;
+    volatile long double sink;
+};
+
+#define DEFINE_FLOATING_ARITH_BENCH(name, type)                          \
+static void bench_add_##name(void *ctx, unsigned long n) {               \
+    struct floating_arith_ctx *const c = ctx;                             \
+    const type y = (type)c->y;                                            \
+    type x = (type)c->start;                                              \
+    unsigned long i;                                                      \
+    for (i = 0; i < n; i += 2) {                                          \
+        x = x + y;                                                        \
+        x = x - y;                                                        \
+    }                                                                     \
+    c->sink = (long double)x;                                             \
+}                                                                         \
+static void bench_mul_##name(void *ctx, unsigned long n) {               \
+    struct floating_arith_ctx *const c = ctx;                             \
+    const type y = (type)c->y;                                            \
+    const type y_inverse = (type)c->y_inverse;                            \
+    type x = (type)c->start;                                              \
+    unsigned long i;                                                      \
+    for (i = 0; i < n; i += 2) {                                          \
+        x = x * y;                                                        \
+        x = x * y_inverse;                                                \
+    }                                                                     \
+    c->sink = (long double)x;                                             \
+}                                                                         \
+static void bench_div_##name(void *ctx, unsigned long n) {               \
+    struct floating_arith_ctx *const c = ctx;                             \
+    const type y = (type)c->y;                                            \
+    const type y_inverse = (type)c->y_inverse;                            \
+    type x = (type)c->start;                                              \
+    unsigned long i;                                                      \
+    for (i = 0; i < n; i += 2) {                                          \
+        x = x / y;                                                        \
+        x = x / y_inverse;                                                \
+    }                                                                     \
+    c->sink = (long double)x;                                             \
+}
+
+#define DEFINE_FLOATING_SQRT_BENCH(name, type, sqrt_func)                \
+static void bench_sqrt_##name(void *ctx, unsigned long n) {              \
+    struct floating_arith_ctx *const c = ctx;                             \
+    const type addend = (type)1.5;                                        \
+    type x = (type)c->start;                                              \
+    unsigned long i;                                                      \
+    for (i = 0; i < n; i ++) {                                            \
+        x = sqrt_func(x) + addend;                                        \
+    }                                                                     \
+    c->sink = (long double)x;                                             \
+}
+
+DEFINE_FLOATING_ARITH_BENCH(float, float)
+DEFINE_FLOATING_SQRT_BENCH(float, float, sqrtf)
+DEFINE_FLOATING_ARITH_BENCH(double, double)
+DEFINE_FLOATING_SQRT_BENCH(double, double, sqrt)
+#ifdef LONG_DOUBLE_EXISTS
+DEFINE_FLOATING_ARITH_BENCH(long_double, long double)
+DEFINE_FLOATING_SQRT_BENCH(long_double, long double, sqrtl)
+#endif
+#ifdef FLOAT128_EXISTS
+DEFINE_FLOATING_ARITH_BENCH(float128, float128)
+#ifdef __GLIBC__
+/* glibc's libm provides sqrtf128(), which the builtin calls */
+DEFINE_FLOATING_SQRT_BENCH(float128, float128, __builtin_sqrtf128)
+#define FLOAT128_SQRT bench_sqrt_float128
+#else
+#define FLOAT128_SQRT NULL
+#endif
+#endif
+
+struct floating_arith_type {
+    const char *type_name;
+    bench_fn *add;
+    bench_fn *mul;
+    bench_fn *div;
+    bench_fn *sqrt;  /* may be NULL */
+};
+
+static const struct floating_arith_type floating_arith_types[] = {
+    { "float", bench_add_float, bench_mul_float, bench_div_float, bench_sqrt_float },
+    { "double", bench_add_double, bench_mul_double, bench_div_double, bench_sqrt_double },
+#ifdef LONG_DOUBLE_EXISTS
+    { "long double", bench_add_long_double, bench_mul_long_double, bench_div_long_double,
+                     bench_sqrt_long_double },
+#endif
+#ifdef FLOAT128_EXISTS
+    { "__float128", bench_add_float128, bench_mul_float128, bench_div_float128, FLOAT128_SQRT },
+#endif
+};
+
+static void show_floating_arithmetic(FILE *out) {
+    const size_t count = sizeof floating_arith_types / sizeof floating_arith_types[0];
+    double ns[sizeof floating_arith_types / sizeof floating_arith_types[0]][3];
+    struct floating_arith_ctx c;
+    size_t t;
+
+    fputs("[floating_arithmetic]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    emulated_threshold = %g\n", EMULATED_SLOWDOWN);
+    c.start = 1.25L;
+    c.y = 1.0009765625L;   /* 1 + 2**-10 */
+    c.y_inverse = 1.0L / c.y;
+
+    for (t = 0; t < count; t ++) {
+        const struct floating_arith_type *const ft = &floating_arith_types[t];
+        bench_fn *const ops[3] = { ft->add, ft->mul, ft->div };
+        static const char *const op_names[3] = { "add", "mul", "div" };
+        struct measurement m;
+        char name[NAME_SIZE];
+        char key[KEY_SIZE];
+        int op;
+
+        for (op = 0; op < 3; op ++) {
+            measure(ops[op], &c, &m);
+            ns[t][op] = m.ns_per_op;
+            snprintf(key, sizeof key, "%s.%s", space_to_hyphen(name, ft->type_name), op_names[op]);
+            show_ns(out, key, &m);
+        }
+        if (ft->sqrt != NULL) {
+            measure(ft->sqrt, &c, &m);
+            snprintf(key, sizeof key, "%s.sqrt", space_to_hyphen(name, ft->type_name));
+            show_ns(out, key, &m);
+        }
+    }
+
+    /* floating_arith_types[1] is double */
+    for (t = 0; t < count; t ++) {
+        char name[NAME_SIZE];
+        double slowdown = 1.0;
+        int op;
+        space_to_hyphen(name, floating_arith_types[t].type_name);
+        for (op = 0; op < 3; op ++) {
+            slowdown *= ns[t][op] / ns[1][op];
+        }
+        slowdown = pow(slowdown, 1.0 / 3.0);
+        fprintf(out, "    %s.slowdown_vs_double = %.2f\n", name, slowdown);
+        fprintf(out, "    %s.emulated = %s\n", name, slowdown > EMULATED_SLOWDOWN ? "true" : "false");
+    }
+    putc('\n', out);
+} /* show_floating_arithmetic */
+
+/*
+ * Multibyte and wide character conversion.  The input is UTF-8 text,
+ * either mostly ASCII or mostly CJK (3-byte sequences), converted with
+ * the library functions in a UTF-8 LC_CTYPE locale and with a plain
+ * hand-written UTF-8 decoding loop.  Rates are in MB of UTF-8 input
+ * (or output, for wcstombs) per second.
+ */
+
+#define MB_TEXT_BYTES 65536
+
+struct mb_ctx {
+    char text[MB_TEXT_BYTES + 4];
+    size_t length;
+    wchar_t wide[MB_TEXT_BYTES + 1];
+    size_t wide_length;
+    volatile longest_unsigned sink;
+};
+
+static const char *const utf8_locales[] = {
+    "C.UTF-8", "C.utf8", "en_US.UTF-8", "en_US.utf8", ""
+};
+
+/*
+ * Sets LC_CTYPE to a UTF-8 locale and returns its name, or returns NULL
+ * (leaving LC_CTYPE as "C") if there isn't one.
+ */
+static const char *set_utf8_locale(void) {
+    static const char cjk[] = "\xe4\xb8\xad";  /* U+4E2D */
+    size_t i;
+    for (i = 0; i < sizeof utf8_locales / sizeof utf8_locales[0]; i ++) {
+        if (setlocale(LC_CTYPE, utf8_locales[i]) != NULL) {
+            mbstate_t state;
+            wchar_t wc;
+            memset(&state, 0, sizeof state);
+            if (mbrtowc(&wc, cjk, 3, &state) == 3 && wc == 0x4e2d) {
+                return utf8_locales[i][0] == '\0' ? "default" : utf8_locales[i];
+            }
+        }
+    }
+    setlocale(LC_CTYPE, "C");
+    return NULL;
+} /* set_utf8_locale */
+
+/*
+ * Fills the buffer with UTF-8 text.  cjk_percent of the characters
+ * are CJK ideographs, the rest are printable ASCII.
+ */
+static void fill_utf8_text(struct mb_ctx *c, int cjk_percent) {
+    uint_least64_t state = 30;
+    size_t n = 0;
+    while (n + 3 <= MB_TEXT_BYTES) {
+        const uint_least64_t r = bench_random(&state);
+        if ((int)(r % 100) < cjk_percent) {
+            const unsigned cp = 0x4e00 + (unsigned)(r >> 32) % 0x5000;
+            c->text[n++] = (char)(0xe0 | (cp >> 12));
+            c->text[n++] = (char)(0x80 | ((cp >> 6) & 0x3f));
+            c->text[n++] = (char)(0x80 | (cp & 0x3f));
+        }
+        else {
+            c->text[n++] = (char)(' ' + (r >> 32) % 95);
+        }
+    }
+    c->text[n] = '\0';
+    c->length = n;
+    c->wide_length = mbstowcs(c->wide, c->text, MB_TEXT_BYTES + 1);
+} /* fill_utf8_text */
+
+static void bench_mbstowcs(void *ctx, unsigned long n) {
+    struct mb_ctx *const c = ctx;
+    longest_unsigned total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        total += mbstowcs(c->wide, c->text, MB_TEXT_BYTES + 1);
+    }
+    c->sink = total;
+}
+
+static void bench_wcstombs(void *ctx, unsigned long n) {
+    struct mb_ctx *const c = ctx;
+    char out[MB_TEXT_BYTES + 4];
+    longest_unsigned total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        total += wcstombs(out, c->wide, sizeof out);
+    }
+    c->sink = total + (unsigned char)out[0];
+}
+
+static void bench_mbrtowc(void *ctx, unsigned long n) {
+    struct mb_ctx *const c = ctx;
+    longest_unsigned total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        mbstate_t state;
+        const char *p = c->text;
+        const char *const end = c->text + c->length;
+        memset(&state, 0, sizeof state);
+        while (p < end) {
+            wchar_t wc;
+            const size_t len = mbrtowc(&wc, p, (size_t)(end - p), &state);
+            if (len == 0 || len > MB_LEN_MAX) {
+                break;
+            }
+            total += (longest_unsigned)wc;
+            p += len;
+        }
+    }
+    c->sink = total;
+}
+
+#ifdef UCHAR_H_EXISTS
+#define DEFINE_MBRTOC_BENCH(name, char_type)                                \
+static void bench_##name(void *ctx, unsigned long n) {                      \
+    struct mb_ctx *const c = ctx;                                            \
+    longest_unsigned total = 0;                                              \
+    unsigned long i;                                                         \
+    for (i = 0; i < n; i ++) {                                               \
+        mbstate_t state;                                                     \
+        const char *p = c->text;                                             \
+        const char *const end = c->text + c->length;                         \
+        memset(&state, 0, sizeof state);                                     \
+        while (p < end) {                                                    \
+            char_type ch;                                                    \
+            const size_t len = name(&ch, p, (size_t)(end - p), &state);      \
+            if (len == (size_t)-3) {                                         \
+                total += ch;  /* second half of a surrogate pair */         \
+                continue;                                                    \
+            }                                                                \
+            if (len == 0 || len > MB_LEN_MAX) {                              \
+                break;                                                       \
+            }                                                                \
+            total += ch;                                                     \
+            p += len;                                                        \
+        }                                                                    \
+    }                                                                        \
+    c->sink = total;                                                         \
+}
+DEFINE_MBRTOC_BENCH(mbrtoc16, char16_t)
+DEFINE_MBRTOC_BENCH(mbrtoc32, char32_t)
+#endif
+
+/*
+ * A straightforward UTF-8 decoder that assumes valid input, for
+ * comparison with the library.
+ */
+static void bench_utf8_loop(void *ctx, unsigned long n) {
+    struct mb_ctx *const c = ctx;
+    const unsigned char *const text = (const unsigned char *)c->text;
+    const size_t length = c->length;
+    longest_unsigned total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        size_t p = 0;
+        while (p < length) {
+            const unsigned b = text[p];
+            uint_least32_t cp;
+            if (b < 0x80) {
+                cp = b;
+                p += 1;
+            }
+            else if (b < 0xe0) {
+                cp = ((b & 0x1fu) << 6) | (text[p + 1] & 0x3fu);
+                p += 2;
+            }
+            else if (b < 0xf0) {
+                cp = ((b & 0x0fu) << 12) | ((text[p + 1] & 0x3fu) << 6) | (text[p + 2] & 0x3fu);
+                p += 3;
+            }
+            else {
+                cp = ((b & 0x07u) << 18) | ((text[p + 1] & 0x3fu) << 12)
+                     | ((text[p + 2] & 0x3fu) << 6) | (text[p + 3] & 0x3fu);
+                p += 4;
+            }
+            total += cp;
+        }
+    }
+    c->sink = total;
+} /* bench_utf8_loop */
+
+struct mb_conversion {
+    const char *name;
+    bench_fn *bench;
+};
+
+static const struct mb_conversion mb_conversions[] = {
+    { "mbstowcs", bench_mbstowcs },
+    { "wcstombs", bench_wcstombs },
+    { "mbrtowc",  bench_mbrtowc },
+#ifdef UCHAR_H_EXISTS
+    { "mbrtoc16", bench_mbrtoc16 },
+    { "mbrtoc32", bench_mbrtoc32 },
+#endif
+    { "utf8_loop", bench_utf8_loop },
+};
+
+static void show_multibyte_conversion(FILE *out) {
+    static const struct { const char *name; int cjk_percent; } inputs[] = {
+        { "ascii_heavy", 5 },
+        { "cjk_heavy", 90 },
+    };
+    struct mb_ctx *const c = malloc(sizeof *c);
+    const char *locale;
+    size_t i, j;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[multibyte_conversion]\n", out);
+    fputs("    kind = measurement\n", out);
+    locale = set_utf8_locale();
+    if (locale == NULL) {
+        fputs("    utf8_locale = none\n", out);
+        putc('\n', out);
+        free(c);
+        return;
+    }
+    fprintf(out, "    utf8_locale = \"%s\"\n", locale);
+    fprintf(out, "    MB_CUR_MAX = %d\n", (int)MB_CUR_MAX);
+    fprintf(out, "    wchar_t_size = %d\n", (int)(sizeof(wchar_t) * CHAR_BIT));
+    for (i = 0; i < sizeof inputs / sizeof inputs[0]; i ++) {
+        fill_utf8_text(c, inputs[i].cjk_percent);
+        fprintf(out, "    %s.bytes_per_character = %.2f\n",
+               inputs[i].name, (double)c->length / (double)c->wide_length);
+        for (j = 0; j < sizeof mb_conversions / sizeof mb_conversions[0]; j ++) {
+            struct measurement m;
+            char key[KEY_SIZE];
+            measure(mb_conversions[j].bench, c, &m);
+            snprintf(key, sizeof key, "%s.%s", inputs[i].name, mb_conversions[j].name);
+            show_rate(out, key, "mb", &m, (double)c->length);
+        }
+    }
+    setlocale(LC_CTYPE, "C");
+    putc('\n', out);
+    free(c);
+} /* show_multibyte_conversion */
+
+/*
+ * Bit-field access.  A 32-bit record header with a 4-bit kind, 8 bits
+ * of flags and a 20-bit length is stored either as a struct with
+ * bit-fields or as an unsigned with hand-written shifts and masks.
+ * Each benchmark walks an array of headers, reading two fields,
+ * toggling one flag, or incrementing the (wrapping) flags field as a
+ * whole; the times are per header.  mask_speedup is the bit-field time
+ * divided by the mask time.
+ */
+
+#if UINT_MAX >= 0xffffffff
+
+#define HEADER_COUNT 4096  /* must be a power of 2 */
+
+struct record_header {
+    unsigned kind : 4;
+    unsigned flags : 8;
+    unsigned length : 20;
+};
+
+#define HEADER_KIND_MASK    0xfU
+#define HEADER_FLAGS_SHIFT  4
+#define HEADER_FLAGS_MASK   (0xffU << HEADER_FLAGS_SHIFT)
+#define HEADER_LENGTH_SHIFT 12
+
+struct bitfield_ctx {
+    struct record_header fields[HEADER_COUNT];
+    unsigned words[HEADER_COUNT];
+    volatile unsigned long sink;
+};
+
+static void bench_read_bitfield(void *ctx, unsigned long n) {
+    struct bitfield_ctx *const c = ctx;
+    unsigned long total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        const struct record_header *const h = &c->fields[i & (HEADER_COUNT - 1)];
+        total += h->length + h->kind;
+    }
+    c->sink = total;
+}
+
+static void bench_read_mask(void *ctx, unsigned long n) {
+    struct bitfield_ctx *const c = ctx;
+    unsigned long total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        const unsigned w = c->words[i & (HEADER_COUNT - 1)];
+        total += (w >> HEADER_LENGTH_SHIFT) + (w & HEADER_KIND_MASK);
+    }
+    c->sink = total;
+}
+
+static void bench_toggle_flag_bitfield(void *ctx, unsigned long n) {
+    struct bitfield_ctx *const c = ctx;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        c->fields[i & (HEADER_COUNT - 1)].flags ^= 1U << (i & 7);
+    }
+    c->sink = c->fields[0].flags;
+}
+
+static void bench_toggle_flag_mask(void *ctx, unsigned long n) {
+    struct bitfield_ctx *const c = ctx;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        c->words[i & (HEADER_COUNT - 1)] ^= 1U << (HEADER_FLAGS_SHIFT + (i & 7));
+    }
+    c->sink = c->words[0];
+}
+
+static void bench_increment_field_bitfield(void *ctx, unsigned long n) {
+    struct bitfield_ctx *const c = ctx;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        c->fields[i & (HEADER_COUNT - 1)].flags ++;
+    }
+    c->sink = c->fields[0].flags;
+}
+
+static void bench_increment_field_mask(void *ctx, unsigned long n) {
+    struct bitfield_ctx *const c = ctx;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        unsigned *const w = &c->words[i & (HEADER_COUNT - 1)];
+        *w = (*w & ~HEADER_FLAGS_MASK) | ((*w + (1U << HEADER_FLAGS_SHIFT)) & HEADER_FLAGS_MASK);
+    }
+    c->sink = c->words[0];
+}
+
+static void show_bitfield_access(FILE *out) {
+    static const struct {
+        const char *name;
+        bench_fn *bitfield;
+        bench_fn *mask;
+    } ops[] = {
+        { "read",            bench_read_bitfield,            bench_read_mask },
+        { "toggle_flag",     bench_toggle_flag_bitfield,     bench_toggle_flag_mask },
+        { "increment_field", bench_increment_field_bitfield, bench_increment_field_mask }
+    };
+    struct bitfield_ctx *const c = malloc(sizeof *c);
+    uint_least64_t state = 33;
+    size_t i;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < HEADER_COUNT; i ++) {
+        const unsigned w = (unsigned)(bench_random(&state) & 0xffffffffU);
+        c->fields[i].kind = w & HEADER_KIND_MASK;
+        c->fields[i].flags = (w & HEADER_FLAGS_MASK) >> HEADER_FLAGS_SHIFT;
+        c->fields[i].length = w >> HEADER_LENGTH_SHIFT;
+        c->words[i] = w;
+    }
+
+    fputs("[bitfield_access]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (i = 0; i < sizeof ops / sizeof ops[0]; i ++) {
+        struct measurement bitfield, mask;
+        char key[KEY_SIZE];
+        measure(ops[i].bitfield, c, &bitfield);
+        measure(ops[i].mask, c, &mask);
+        snprintf(key, sizeof key, "%s.bitfield", ops[i].name);
+        show_ns(out, key, &bitfield);
+        snprintf(key, sizeof key, "%s.mask", ops[i].name);
+        show_ns(out, key, &mask);
+        fprintf(out, "    %s.mask_speedup = %.2f\n", ops[i].name, bitfield.ns_per_op / mask.ns_per_op);
+    }
+    putc('\n', out);
+    free(c);
+} /* show_bitfield_access */
+
+#endif /* UINT_MAX >= 0xffffffff */
+
+/*
+ * Struct passing.  Structs of 4 to 128 bytes made of int members, of
+ * float members, or of {int, float} pairs ("mixed") are passed to and
+ * returned from functions called through a volatile function pointer
+ * (so they can't be inlined), by value and by pointer.  "pass" calls
+ * a function that reads the first and last members of its argument;
+ * "return" calls one that fills in every member.  Times are per call.
+ *
+ * Small structs are typically passed in registers and larger ones in
+ * memory, either on the stack or as a pointer to a copy in the
+ * caller's frame.  Where the compiler has __builtin_dwarf_cfa(), an
+ * argument that the callee finds at or above its canonical frame
+ * address (the stack pointer at the call, assuming the stack grows
+ * downward) was passed in memory; one passed in registers can only have
+ * been stored in the callee's own frame, below it.  That's shown as
+ * in_memory, and pass.register_limit is the largest size, in bits,
+ * before the first such argument; otherwise it's "unknown".  No limit
+ * is shown for return values: C can't see where a return value is put,
+ * and the return timings don't track it (a 12-byte int struct returned
+ * in registers can be slower than a 32-byte one returned in memory).
+ */
+
+struct mixed_pair {
+    int i;
+    float f;
+};
+
+#define SET_SCALAR(e, x) ((e) = (x))
+#define GET_SCALAR(e) ((int)(e))
+#define SET_PAIR(e, x) ((e).i = (x), (e).f = (float)(x))
+#define GET_PAIR(e) ((e).i + (int)(e).f)
+
+struct struct_passing_ctx {
+    volatile int seed;
+    volatile int sink;
+};
+
+#ifdef DWARF_CFA_EXISTS
+#define DEFINE_IN_MEMORY_PROBE(name)                                        \
+static int passed_in_memory_##name(struct pass_##name s) {                  \
+    return (char *)&s >= (char *)__builtin_dwarf_cfa();                     \
+}                                                                           \
+static int (*volatile passed_in_memory_ptr_##name)(struct pass_##name) = passed_in_memory_##name; \
+static bool in_memory_##name(void) {                                        \
+    struct pass_##name s;                                                   \
+    memset(&s, 0, sizeof s);                                                \
+    return passed_in_memory_ptr_##name(s);                                  \
+}
+#define IN_MEMORY_PROBE(name) in_memory_##name
+#else
+#define DEFINE_IN_MEMORY_PROBE(name)
+#define IN_MEMORY_PROBE(name) NULL
+#endif
+
+#define DEFINE_STRUCT_PASSING(name, type, count, set, get)                  \
+struct pass_##name {                                                        \
+    type v[count];                                                          \
+};                                                                          \
+DEFINE_IN_MEMORY_PROBE(name)                                                \
+static int read_value_##name(struct pass_##name s) {                        \
+    return get(s.v[0]) + get(s.v[count - 1]);                               \
+}                                                                           \
+static int read_pointer_##name(const struct pass_##name *s) {               \
+    return get(s->v[0]) + get(s->v[count - 1]);                             \
+}                                                                           \
+static struct pass_##name make_value_##name(int x) {                        \
+    struct pass_##name s;                                                   \
+    int i;                                                                  \
+    for (i = 0; i < count; i ++) {                                          \
+        set(s.v[i], x + i);                                                 \
+    }                                                                       \
+    return s;                                                               \
+}                                                                           \
+static void make_pointer_##name(struct pass_##name *s, int x) {             \
+    int i;                                                                  \
+    for (i = 0; i < count; i ++) {                                          \
+        set(s->v[i], x + i);                                                \
+    }                                                                       \
+}                                                                           \
+static int (*volatile read_value_ptr_##name)(struct pass_##name) = read_value_##name; \
+static int (*volatile read_pointer_ptr_##name)(const struct pass_##name *) = read_pointer_##name; \
+static struct pass_##name (*volatile make_value_ptr_##name)(int) = make_value_##name; \
+static void (*volatile make_pointer_ptr_##name)(struct pass_##name *, int) = make_pointer_##name; \
+static void bench_pass_value_##name(void *ctx, unsigned long n) {           \
+    struct struct_passing_ctx *const c = ctx;                               \
+    int (*const f)(struct pass_##name) = read_value_ptr_##name;             \
+    struct pass_##name s;                                                   \
+    int total = 0;                                                          \
+    unsigned long i;                                                        \
+    make_pointer_##name(&s, c->seed);                                       \
+    for (i = 0; i < n; i ++) {                                              \
+        total += f(s);                                                      \
+    }                                                                       \
+    c->sink = total;                                                        \
+}                                                                           \
+static void bench_pass_pointer_##name(void *ctx, unsigned long n) {         \
+    struct struct_passing_ctx *const c = ctx;                               \
+    int (*const f)(const struct pass_##name *) = read_pointer_ptr_##name;   \
+    struct pass_##name s;                                                   \
+    int total = 0;                                                          \
+    unsigned long i;                                                        \
+    make_pointer_##name(&s, c->seed);                                       \
+    for (i = 0; i < n; i ++) {                                              \
+        total += f(&s);                                                     \
+    }                                                                       \
+    c->sink = total;                                                        \
+}                                                                           \
+static void bench_return_value_##name(void *ctx, unsigned long n) {         \
+    struct struct_passing_ctx *const c = ctx;                               \
+    struct pass_##name (*const f)(int) = make_value_ptr_##name;             \
+    const int seed = c->seed;                                               \
+    int total = 0;                                                          \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const struct pass_##name s = f(seed + (int)(i & 0xff));             \
+        total += get(s.v[count - 1]);                                       \
+    }                                                                       \
+    c->sink = total;                                                        \
+}                                                                           \
+static void bench_return_pointer_##name(void *ctx, unsigned long n) {       \
+    struct struct_passing_ctx *const c = ctx;                               \
+    void (*const f)(struct pass_##name *, int) = make_pointer_ptr_##name;   \
+    const int seed = c->seed;                                               \
+    struct pass_##name s;                                                   \
+    int total = 0;                                                          \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        f(&s, seed + (int)(i & 0xff));                                      \
+        total += get(s.v[count - 1]);                                       \
+    }                                                                       \
+    c->sink = total;                                                        \
+}
+
+#define DEFINE_STRUCT_PASSING_INT(bytes) \
+    DEFINE_STRUCT_PASSING(int_##bytes, int, bytes / 4, SET_SCALAR, GET_SCALAR)
+#define DEFINE_STRUCT_PASSING_FLOAT(bytes) \
+    DEFINE_STRUCT_PASSING(float_##bytes, float, bytes / 4, SET_SCALAR, GET_SCALAR)
+#define DEFINE_STRUCT_PASSING_MIXED(bytes) \
+    DEFINE_STRUCT_PASSING(mixed_##bytes, struct mixed_pair, bytes / 8, SET_PAIR, GET_PAIR)
+
+DEFINE_STRUCT_PASSING_INT(4)
+DEFINE_STRUCT_PASSING_INT(8)
+DEFINE_STRUCT_PASSING_INT(12)
+DEFINE_STRUCT_PASSING_INT(16)
+DEFINE_STRUCT_PASSING_INT(24)
+DEFINE_STRUCT_PASSING_INT(32)
+DEFINE_STRUCT_PASSING_INT(48)
+DEFINE_STRUCT_PASSING_INT(64)
+DEFINE_STRUCT_PASSING_INT(128)
+DEFINE_STRUCT_PASSING_FLOAT(4)
+DEFINE_STRUCT_PASSING_FLOAT(8)
+DEFINE_STRUCT_PASSING_FLOAT(12)
+DEFINE_STRUCT_PASSING_FLOAT(16)
+DEFINE_STRUCT_PASSING_FLOAT(24)
+DEFINE_STRUCT_PASSING_FLOAT(32)
+DEFINE_STRUCT_PASSING_FLOAT(48)
+DEFINE_STRUCT_PASSING_FLOAT(64)
+DEFINE_STRUCT_PASSING_FLOAT(128)
+DEFINE_STRUCT_PASSING_MIXED(8)
+DEFINE_STRUCT_PASSING_MIXED(16)
+DEFINE_STRUCT_PASSING_MIXED(24)
+DEFINE_STRUCT_PASSING_MIXED(32)
+DEFINE_STRUCT_PASSING_MIXED(48)
+DEFINE_STRUCT_PASSING_MIXED(64)
+DEFINE_STRUCT_PASSING_MIXED(128)
+
+/*
+ * The sizes of each kind must be in increasing order, and the kinds
+ * must be grouped together.
+ */
+struct struct_passing_bench {
+    const char *kind;
+    size_t size;
+    bench_fn *pass_value;
+    bench_fn *pass_pointer;
+    bench_fn *return_value;
+    bench_fn *return_pointer;
+    bool (*in_memory)(void);
+};
+
+#define STRUCT_PASSING_BENCH(kind, bytes)                                   \
+    { #kind, sizeof (struct pass_##kind##_##bytes),                         \
+      bench_pass_value_##kind##_##bytes,   bench_pass_pointer_##kind##_##bytes, \
+      bench_return_value_##kind##_##bytes, bench_return_pointer_##kind##_##bytes, \
+      IN_MEMORY_PROBE(kind##_##bytes) }
+
+static const struct struct_passing_bench struct_passing_benches[] = {
+    STRUCT_PASSING_BENCH(int, 4),
+    STRUCT_PASSING_BENCH(int, 8),
+    STRUCT_PASSING_BENCH(int, 12),
+    STRUCT_PASSING_BENCH(int, 16),
+    STRUCT_PASSING_BENCH(int, 24),
+    STRUCT_PASSING_BENCH(int, 32),
+    STRUCT_PASSING_BENCH(int, 48),
+    STRUCT_PASSING_BENCH(int, 64),
+    STRUCT_PASSING_BENCH(int, 128),
+    STRUCT_PASSING_BENCH(float, 4),
+    STRUCT_PASSING_BENCH(float, 8),
+    STRUCT_PASSING_BENCH(float, 12),
+    STRUCT_PASSING_BENCH(float, 16),
+    STRUCT_PASSING_BENCH(float, 24),
+    STRUCT_PASSING_BENCH(float, 32),
+    STRUCT_PASSING_BENCH(float, 48),
+    STRUCT_PASSING_BENCH(float, 64),
+    STRUCT_PASSING_BENCH(float, 128),
+    STRUCT_PASSING_BENCH(mixed, 8),
+    STRUCT_PASSING_BENCH(mixed, 16),
+    STRUCT_PASSING_BENCH(mixed, 24),
+    STRUCT_PASSING_BENCH(mixed, 32),
+    STRUCT_PASSING_BENCH(mixed, 48),
+    STRUCT_PASSING_BENCH(mixed, 64),
+    STRUCT_PASSING_BENCH(mixed, 128)
+};
+
+#define STRUCT_PASSING_COUNT (sizeof struct_passing_benches / sizeof struct_passing_benches[0])
+
+/*
+ * Returns the register limit for passing, in bits, from the in_memory
+ * probes, or -1 if there are none.
+ */
+static int pass_register_limit(size_t first, size_t last) {
+    size_t i;
+    if (struct_passing_benches[first].in_memory == NULL) {
+        return -1;
+    }
+    for (i = first; i < last; i ++) {
+        if (struct_passing_benches[i].in_memory()) {
+            break;
+        }
+    }
+    return i == first ? 0 : (int)(struct_passing_benches[i - 1].size * CHAR_BIT);
+} /* pass_register_limit */
+
+static void show_struct_passing(FILE *out) {
+    struct struct_passing_ctx c;
+    size_t first = 0;
+    size_t i;
+
+    fputs("[struct_passing]\n", out);
+    fputs("    kind = measurement\n", out);
+    c.seed = 34;
+    for (i = 0; i < STRUCT_PASSING_COUNT; i ++) {
+        const struct struct_passing_bench *const b = &struct_passing_benches[i];
+        const int bits = (int)(b->size * CHAR_BIT);
+        struct measurement m;
+        char key[KEY_SIZE];
+
+        measure(b->pass_value, &c, &m);
+        snprintf(key, sizeof key, "%s.%d.pass.value", b->kind, bits);
+        show_ns(out, key, &m);
+        measure(b->pass_pointer, &c, &m);
+        snprintf(key, sizeof key, "%s.%d.pass.pointer", b->kind, bits);
+        show_ns(out, key, &m);
+        if (b->in_memory != NULL) {
+            fprintf(out, "    %s.%d.pass.in_memory = %s\n", b->kind, bits, b->in_memory() ? "true" : "false");
+        }
+        measure(b->return_value, &c, &m);
+        snprintf(key, sizeof key, "%s.%d.return.value", b->kind, bits);
+        show_ns(out, key, &m);
+        measure(b->return_pointer, &c, &m);
+        snprintf(key, sizeof key, "%s.%d.return.pointer", b->kind, bits);
+        show_ns(out, key, &m);
+
+        if (i + 1 == STRUCT_PASSING_COUNT || strcmp(struct_passing_benches[i + 1].kind, b->kind) != 0) {
+            const int limit = pass_register_limit(first, i + 1);
+            if (limit < 0) {
+                fprintf(out, "    %s.pass.register_limit = unknown\n", b->kind);
+            }
+            else {
+                fprintf(out, "    %s.pass.register_limit = %d\n", b->kind, limit);
+            }
+            first = i + 1;
+        }
+    }
+    putc('\n', out);
+} /* show_struct_passing */
+
+/*
+ * Address space.  Pointers are usually wider than the addresses a
+ * process actually gets.  The number of significant bits is shown for
+ * the addresses of a static object, a local variable, small and large
+ * malloc() blocks and (on POSIX systems) an anonymous mmap() region;
+ * observed_address_bits is the largest of these.  Since addresses are
+ * usually randomized, these vary from run to run.
+ *
+ * The cost of compressing links is measured by following a random
+ * cycle through an array of nodes linked either by pointers or by
+ * 32-bit byte offsets from the start of the array, for arrays that
+ * typically fit in L1, in L2 and in neither.  The times are per node
+ * visited.
+ */
+
+#ifdef UINTPTR_MAX
+
+#define LINK_NODE_COUNTS { 1024, 32768, 1048576 }
+
+struct pointer_node {
+    struct pointer_node *next;
+    uint_least32_t payload;
+};
+
+struct offset_node {
+    uint_least32_t next;     /* byte offset from the start of the array */
+    uint_least32_t payload;
+};
+
+struct link_ctx {
+    struct pointer_node *pointer_nodes;
+    struct offset_node *offset_nodes;
+    size_t *order;
+    volatile uint_least32_t sink;
+};
+
+static int address_bits(const void *p) {
+    uintptr_t a = (uintptr_t)p;
+    int bits = 0;
+    while (a != 0) {
+        a >>= 1;
+        bits ++;
+    }
+    return bits;
+}
+
+static void bench_pointer_links(void *ctx, unsigned long n) {
+    struct link_ctx *const c = ctx;
+    const struct pointer_node *p = c->pointer_nodes;
+    uint_least32_t total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        total += p->payload;
+        p = p->next;
+    }
+    c->sink = total;
+}
+
+static void bench_offset_links(void *ctx, unsigned long n) {
+    struct link_ctx *const c = ctx;
+    const char *const base = (const char *)c->offset_nodes;
+    const struct offset_node *p = c->offset_nodes;
+    uint_least32_t total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        total += p->payload;
+        p = (const struct offset_node *)(base + p->next);
+    }
+    c->sink = total;
+}
+
+/*
+ * Links count nodes into one random cycle (Sattolo's algorithm), the
+ * same for both kinds of node.
+ */
+static void make_link_cycle(struct link_ctx *c, size_t count) {
+    uint_least64_t state = 35;
+    size_t i;
+    for (i = 0; i < count; i ++) {
+        c->order[i] = i;
+    }
+    for (i = count - 1; i > 0; i --) {
+        const size_t j = (size_t)(bench_random(&state) % i);
+        const size_t tmp = c->order[i];
+        c->order[i] = c->order[j];
+        c->order[j] = tmp;
+    }
+    for (i = 0; i < count; i ++) {
+        const size_t next = c->order[i];
+        c->pointer_nodes[i].next = &c->pointer_nodes[next];
+        c->pointer_nodes[i].payload = (uint_least32_t)i;
+        c->offset_nodes[i].next = (uint_least32_t)(next * sizeof (struct offset_node));
+        c->offset_nodes[i].payload = (uint_least32_t)i;
+    }
+} /* make_link_cycle */
+
+static void show_address_space(FILE *out) {
+    static const size_t counts[] = LINK_NODE_COUNTS;
+    const size_t max_count = counts[sizeof counts / sizeof counts[0] - 1];
+    static const char static_object = 0;
+    const char local_object = 0;
+    void *const small_block = malloc(16);
+    void *const large_block = malloc(16 * 1024 * 1024);
+    struct link_ctx c;
+    int observed = 0;
+    int bits;
+    size_t i;
+
+    c.pointer_nodes = malloc(max_count * sizeof *c.pointer_nodes);
+    c.offset_nodes = malloc(max_count * sizeof *c.offset_nodes);
+    c.order = malloc(max_count * sizeof *c.order);
+    if (small_block == NULL || large_block == NULL ||
+        c.pointer_nodes == NULL || c.offset_nodes == NULL || c.order == NULL)
+    {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[address_space]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    pointer_size = %d\n", (int)(CHAR_BIT * sizeof (void*)));
+
+    bits = address_bits(&static_object);
+    fprintf(out, "    static.address_bits = %d\n", bits);
+    observed = bits > observed ? bits : observed;
+    bits = address_bits(&local_object);
+    fprintf(out, "    stack.address_bits = %d\n", bits);
+    observed = bits > observed ? bits : observed;
+    bits = address_bits(small_block);
+    fprintf(out, "    small_heap.address_bits = %d\n", bits);
+    observed = bits > observed ? bits : observed;
+    bits = address_bits(large_block);
+    fprintf(out, "    large_heap.address_bits = %d\n", bits);
+    observed = bits > observed ? bits : observed;
+#if defined(POSIX_EXISTS) && defined(MAP_ANONYMOUS)
+    {
+        void *const region = mmap(NULL, 65536, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED) {
+            bits = address_bits(region);
+            fprintf(out, "    mmap.address_bits = %d\n", bits);
+            observed = bits > observed ? bits : observed;
+            munmap(region, 65536);
+        }
+    }
+#endif
+    fprintf(out, "    observed_address_bits = %d\n", observed);
+    free(small_block);
+    free(large_block);
+
+    fprintf(out, "    pointer_node_size = %d\n", (int)(CHAR_BIT * sizeof (struct pointer_node)));
+    fprintf(out, "    offset_node_size = %d\n", (int)(CHAR_BIT * sizeof (struct offset_node)));
+    fprintf(out, "    offset_memory_saving = %.2f\n",
+            1.0 - (double)sizeof (struct offset_node) / (double)sizeof (struct pointer_node));
+    for (i = 0; i < sizeof counts / sizeof counts[0]; i ++) {
+        struct measurement pointer, offset;
+        char key[KEY_SIZE];
+        make_link_cycle(&c, counts[i]);
+        measure(bench_pointer_links, &c, &pointer);
+        measure(bench_offset_links, &c, &offset);
+        snprintf(key, sizeof key, "nodes_%lu.pointer", (unsigned long)counts[i]);
+        show_ns(out, key, &pointer);
+        snprintf(key, sizeof key, "nodes_%lu.offset", (unsigned long)counts[i]);
+        show_ns(out, key, &offset);
+        fprintf(out, "    nodes_%lu.offset_speedup = %.2f\n",
+                (unsigned long)counts[i], pointer.ns_per_op / offset.ns_per_op);
+    }
+    putc('\n', out);
+    free(c.pointer_nodes);
+    free(c.offset_nodes);
+    free(c.order);
+} /* show_address_space */
+
+#endif /* UINTPTR_MAX */
+
+/*
+ * Bool predicates.  A filter kernel adds up the elements of an array
+ * whose flag is set, with the flags stored either as a bool array or
+ * as a packed bitset, and tested either with an if statement
+ * ("branch") or by using the flag's 0/1 value in arithmetic
+ * ("arithmetic").  The flags are random with several true ratios, and
+ * also 50% true in long runs ("runs_50") so that the branch is easy to
+ * predict.  Times are per element.
+ *
+ * mispredict_penalty is the extra time per element of the bool array
+ * branch at random_50 over runs_50, divided by the 0.5 mispredictions
+ * per element expected at random_50.  bool_flag_size and
+ * bitset_flag_size are the storage per flag in bits.
+ */
+
+#define PREDICATE_COUNT 16384  /* must be a multiple of PREDICATE_WORD_BITS */
+#define PREDICATE_WORD_BITS ((int)(CHAR_BIT * sizeof (unsigned long)))
+
+struct predicate_ctx {
+    unsigned values[PREDICATE_COUNT];
+    bool flags[PREDICATE_COUNT];
+    unsigned long bits[PREDICATE_COUNT / (CHAR_BIT * sizeof (unsigned long))];
+    volatile unsigned long sink;
+};
+
+static void bench_bool_branch(void *ctx, unsigned long n) {
+    struct predicate_ctx *const c = ctx;
+    unsigned long total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        const size_t j = i % PREDICATE_COUNT;
+        if (c->flags[j]) {
+            total += c->values[j];
+        }
+    }
+    c->sink = total;
+}
+
+static void bench_bool_arithmetic(void *ctx, unsigned long n) {
+    struct predicate_ctx *const c = ctx;
+    unsigned long total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        const size_t j = i % PREDICATE_COUNT;
+        total += c->values[j] * (unsigned)c->flags[j];
+    }
+    c->sink = total;
+}
+
+static void bench_bitset_branch(void *ctx, unsigned long n) {
+    struct predicate_ctx *const c = ctx;
+    unsigned long total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        const size_t j = i % PREDICATE_COUNT;
+        if ((c->bits[j / PREDICATE_WORD_BITS] >> (j % PREDICATE_WORD_BITS)) & 1) {
+            total += c->values[j];
+        }
+    }
+    c->sink = total;
+}
+
+static void bench_bitset_arithmetic(void *ctx, unsigned long n) {
+    struct predicate_ctx *const c = ctx;
+    unsigned long total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        const size_t j = i % PREDICATE_COUNT;
+        total += c->values[j] * (unsigned)((c->bits[j / PREDICATE_WORD_BITS] >> (j % PREDICATE_WORD_BITS)) & 1);
+    }
+    c->sink = total;
+}
+
+static void show_bool_predicates(FILE *out) {
+    static const struct {
+        const char *name;
+        int percent_true;
+        bool runs;
+    } patterns[] = {
+        { "random_0",   0,   false },
+        { "random_10",  10,  false },
+        { "random_50",  50,  false },
+        { "random_90",  90,  false },
+        { "random_100", 100, false },
+        { "runs_50",    50,  true }
+    };
+    static const struct {
+        const char *name;
+        bench_fn *fn;
+    } kernels[] = {
+        { "bool.branch",       bench_bool_branch },
+        { "bool.arithmetic",   bench_bool_arithmetic },
+        { "bitset.branch",     bench_bitset_branch },
+        { "bitset.arithmetic", bench_bitset_arithmetic }
+    };
+    struct predicate_ctx *const c = malloc(sizeof *c);
+    double random_50_ns = 0.0;
+    double runs_50_ns = 0.0;
+    size_t p;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[bool_predicates]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    bool_flag_size = %d\n", (int)(CHAR_BIT * sizeof (bool)));
+    fputs("    bitset_flag_size = 1\n", out);
+    for (p = 0; p < sizeof patterns / sizeof patterns[0]; p ++) {
+        uint_least64_t state = 36;
+        size_t i, k;
+
+        memset(c->bits, 0, sizeof c->bits);
+        for (i = 0; i < PREDICATE_COUNT; i ++) {
+            const uint_least64_t r = bench_random(&state);
+            if (patterns[p].runs) {
+                c->flags[i] = (i / 1024) % 2 == 0;
+            }
+            else {
+                c->flags[i] = (int)(r % 100) < patterns[p].percent_true;
+            }
+            c->values[i] = (unsigned)(r >> 32);
+            if (c->flags[i]) {
+                c->bits[i / PREDICATE_WORD_BITS] |= 1UL << (i % PREDICATE_WORD_BITS);
+            }
+        }
+
+        for (k = 0; k < sizeof kernels / sizeof kernels[0]; k ++) {
+            struct measurement m;
+            char key[KEY_SIZE];
+            measure(kernels[k].fn, c, &m);
+            snprintf(key, sizeof key, "%s.%s", patterns[p].name, kernels[k].name);
+            show_ns(out, key, &m);
+            if (kernels[k].fn == bench_bool_branch && patterns[p].percent_true == 50) {
+                if (patterns[p].runs) {
+                    runs_50_ns = m.ns_per_op;
+                }
+                else {
+                    random_50_ns = m.ns_per_op;
+                }
+            }
+        }
+    }
+    fprintf(out, "    mispredict_penalty_ns = %.3f\n", (random_50_ns - runs_50_ns) / 0.5);
+    putc('\n', out);
+    free(c);
+} /* show_bool_predicates */
+
+/*
+ * Enum access.  An array of ENUM_ELEMENTS three-value enums is stored
+ * as the default enum type, as each narrower enum type the compiler
+ * supports, and as unsigned char.  "scan" counts the elements equal to
+ * one value in order; "lookup" reads elements at pseudo-random indexes
+ * and uses them to index a small table.  Times are per element, and
+ * memory_saving is relative to the default enum.
+ */
+
+#define ENUM_ELEMENTS 4194304  /* must be a power of 2 */
+
+#define DEFINE_ENUM_BENCH(name, type)                                       \
+static void bench_enum_scan_##name(void *ctx, unsigned long n) {            \
+    struct enum_ctx *const c = ctx;                                         \
+    const type *const a = c->array;                                         \
+    const type wanted = (type)se_two;                                       \
+    unsigned long count = 0;                                                \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        count += a[i % ENUM_ELEMENTS] == wanted;                            \
+    }                                                                       \
+    c->sink = count;                                                        \
+}                                                                           \
+static void bench_enum_lookup_##name(void *ctx, unsigned long n) {          \
+    struct enum_ctx *const c = ctx;                                         \
+    const type *const a = c->array;                                         \
+    unsigned long total = 0;                                                \
+    unsigned long j = c->seed;                                              \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        j = (j * 1103515245UL + 12345UL) % ENUM_ELEMENTS;                   \
+        total += c->weights[a[j]];                                          \
+    }                                                                       \
+    c->sink = total;                                                        \
+}                                                                           \
+static void fill_enum_##name(void *array, const unsigned char *values) {    \
+    type *const a = array;                                                  \
+    size_t i;                                                               \
+    for (i = 0; i < ENUM_ELEMENTS; i ++) {                                  \
+        a[i] = (type)values[i];                                             \
+    }                                                                       \
+}
+
+struct enum_ctx {
+    void *array;
+    unsigned long weights[3];
+    volatile unsigned long seed;
+    volatile unsigned long sink;
+};
+
+DEFINE_ENUM_BENCH(default, enum small_enum)
+#ifdef __GNUC__
+DEFINE_ENUM_BENCH(packed, enum packed_enum)
+#endif
+#ifdef ENUM_UNDERLYING_TYPE_SUPPORTED
+DEFINE_ENUM_BENCH(fixed_unsigned_char, enum fixed_enum)
+#endif
+DEFINE_ENUM_BENCH(unsigned_char, unsigned char)
+
+struct enum_representation {
+    const char *name;
+    size_t size;
+    void (*fill)(void *array, const unsigned char *values);
+    bench_fn *scan;
+    bench_fn *lookup;
+};
+
+#define ENUM_REPRESENTATION(name, type) \
+    { #name, sizeof (type), fill_enum_##name, bench_enum_scan_##name, bench_enum_lookup_##name }
+
+static const struct enum_representation enum_representations[] = {
+    ENUM_REPRESENTATION(default, enum small_enum),
+#ifdef __GNUC__
+    ENUM_REPRESENTATION(packed, enum packed_enum),
+#endif
+#ifdef ENUM_UNDERLYING_TYPE_SUPPORTED
+    ENUM_REPRESENTATION(fixed_unsigned_char, enum fixed_enum),
+#endif
+    ENUM_REPRESENTATION(unsigned_char, unsigned char)
+};
+
+static void show_enum_access(FILE *out) {
+    unsigned char *const values = malloc(ENUM_ELEMENTS);
+    struct enum_ctx c;
+    uint_least64_t state = 37;
+    size_t i;
+
+    c.array = malloc(ENUM_ELEMENTS * sizeof (enum small_enum));
+    if (values == NULL || c.array == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < ENUM_ELEMENTS; i ++) {
+        values[i] = (unsigned char)(bench_random(&state) % 3);
+    }
+    c.weights[0] = 1;
+    c.weights[1] = 10;
+    c.weights[2] = 100;
+    c.seed = 37;
+
+    fputs("[enum_access]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    elements = %lu\n", (unsigned long)ENUM_ELEMENTS);
+    for (i = 0; i < sizeof enum_representations / sizeof enum_representations[0]; i ++) {
+        const struct enum_representation *const r = &enum_representations[i];
+        struct measurement m;
+        char key[KEY_SIZE];
+
+        r->fill(c.array, values);
+        fprintf(out, "    %s.size = %d\n", r->name, (int)(CHAR_BIT * r->size));
+        fprintf(out, "    %s.memory_saving = %.2f\n", r->name,
+                1.0 - (double)r->size / (double)sizeof (enum small_enum));
+        measure(r->scan, &c, &m);
+        snprintf(key, sizeof key, "%s.scan", r->name);
+        show_ns(out, key, &m);
+        measure(r->lookup, &c, &m);
+        snprintf(key, sizeof key, "%s.lookup", r->name);
+        show_ns(out, key, &m);
+    }
+    putc('\n', out);
+    free(values);
+    free(c.array);
+} /* show_enum_access */
+
+/*
+ * Scratch buffers.  A function called through a volatile pointer (so
+ * it can't be inlined) gets a temporary buffer of 64 bytes to 64 KiB,
+ * writes one byte in every 64 and reads them back.  The buffer comes
+ * from a variable length array, alloca(), a fixed 64 KiB local array,
+ * malloc() and free(), or an arena that's reset after each call.
+ * Times are per call.  stack_limit is the soft RLIMIT_STACK in bytes,
+ * where it's available.
+ */
+
+#if __STDC_VERSION__ >= 199901L && !defined(__STDC_NO_VLA__)
+#    define SCRATCH_VLA_EXISTS
+#endif
+
+#define SCRATCH_MAX 65536
+#define SCRATCH_STRIDE 64
+
+struct scratch_ctx {
+    volatile size_t size;
+    unsigned char *arena;
+    size_t arena_used;
+    volatile unsigned sink;
+};
+
+static unsigned touch_scratch(unsigned char *buf, size_t size) {
+    unsigned total = 0;
+    size_t i;
+    for (i = 0; i < size; i += SCRATCH_STRIDE) {
+        buf[i] = (unsigned char)i;
+    }
+    for (i = 0; i < size; i += SCRATCH_STRIDE) {
+        total += buf[i];
+    }
+    return total;
+}
+
+#ifdef SCRATCH_VLA_EXISTS
+static unsigned scratch_vla(struct scratch_ctx *c, size_t size) {
+    unsigned char buf[size];
+    (void)c;
+    return touch_scratch(buf, size);
+}
+#endif
+
+#ifdef __GNUC__
+static unsigned scratch_alloca(struct scratch_ctx *c, size_t size) {
+    unsigned char *const buf = __builtin_alloca(size);
+    (void)c;
+    return touch_scratch(buf, size);
+}
+#endif
+
+static unsigned scratch_fixed(struct scratch_ctx *c, size_t size) {
+    unsigned char buf[SCRATCH_MAX];
+    (void)c;
+    return touch_scratch(buf, size);
+}
+
+static unsigned scratch_malloc(struct scratch_ctx *c, size_t size) {
+    unsigned char *const buf = malloc(size);
+    unsigned result;
+    (void)c;
+    if (buf == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    result = touch_scratch(buf, size);
+    free(buf);
+    return result;
+}
+
+static unsigned scratch_arena(struct scratch_ctx *c, size_t size) {
+    unsigned char *const buf = c->arena + c->arena_used;
+    unsigned result;
+    c->arena_used += size;
+    result = touch_scratch(buf, size);
+    c->arena_used -= size;
+    return result;
+}
+
+typedef unsigned scratch_fn(struct scratch_ctx *c, size_t size);
+
+static scratch_fn *volatile scratch_target;
+
+static void bench_scratch(void *ctx, unsigned long n) {
+    struct scratch_ctx *const c = ctx;
+    scratch_fn *const f = scratch_target;
+    const size_t size = c->size;
+    unsigned total = 0;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        total += f(c, size);
+    }
+    c->sink = total;
+}
+
+static void show_scratch_buffers(FILE *out) {
+    static const struct {
+        const char *name;
+        scratch_fn *fn;
+    } methods[] = {
+#ifdef SCRATCH_VLA_EXISTS
+        { "vla",    scratch_vla },
+#endif
+#ifdef __GNUC__
+        { "alloca", scratch_alloca },
+#endif
+        { "fixed",  scratch_fixed },
+        { "malloc", scratch_malloc },
+        { "arena",  scratch_arena }
+    };
+    struct scratch_ctx c;
+    size_t size;
+
+    c.arena = malloc(SCRATCH_MAX);
+    c.arena_used = 0;
+    if (c.arena == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[scratch_buffers]\n", out);
+    fputs("    kind = measurement\n", out);
+#if defined(POSIX_EXISTS) && defined(RLIMIT_STACK)
+    {
+        struct rlimit limit;
+        if (getrlimit(RLIMIT_STACK, &limit) == 0) {
+            if (limit.rlim_cur == RLIM_INFINITY) {
+                fputs("    stack_limit = unlimited\n", out);
+            }
+            else {
+                fprintf(out, "    stack_limit = %" PRIuMAX "\n", (uintmax_t)limit.rlim_cur);
+            }
+        }
+    }
+#endif
+    for (size = 64; size <= SCRATCH_MAX; size *= 4) {
+        size_t i;
+        c.size = size;
+        for (i = 0; i < sizeof methods / sizeof methods[0]; i ++) {
+            struct measurement m;
+            char key[KEY_SIZE];
+            scratch_target = methods[i].fn;
+            measure(bench_scratch, &c, &m);
+            snprintf(key, sizeof key, "bytes_%lu.%s", (unsigned long)size, methods[i].name);
+            show_ns(out, key, &m);
+        }
+    }
+    putc('\n', out);
+    free(c.arena);
+} /* show_scratch_buffers */
+
+/*
+ * Complex arithmetic.  Multiplication and division of arrays of
+ * complex numbers, per operation, three ways: with the compiler's
+ * default semantics ("default"; with the Annex G rules for infinities
+ * and NaNs this is often a library call), with #pragma STDC
+ * CX_LIMITED_RANGE ON ("pragma"; only with compilers that honor it,
+ * which excludes gcc), and with the textbook formulas written out
+ * ("formula"), which is what limited range allows.  formula_speedup
+ * is the default time divided by the formula time.
+ *
+ * default_full_range shows whether the default multiplication gets
+ * (inf + inf i) * (1 + 0i) right; it's false if the whole program was
+ * compiled with limited range, e.g. with gcc's -fcx-limited-range or
+ * -ffast-math.
+ */
+
+#ifdef COMPLEX_EXISTS
+
+#define COMPLEX_VALUES 1024  /* must be a power of 2 */
+
+#if !defined(__GNUC__) || defined(__clang__)
+#    define CX_LIMITED_RANGE_PRAGMA_HONORED
+#endif
+
+struct complex_ctx {
+    float _Complex float_a[COMPLEX_VALUES];
+    float _Complex float_b[COMPLEX_VALUES];
+    float _Complex float_r[COMPLEX_VALUES];
+    double _Complex double_a[COMPLEX_VALUES];
+    double _Complex double_b[COMPLEX_VALUES];
+    double _Complex double_r[COMPLEX_VALUES];
+#ifdef LONG_DOUBLE_EXISTS
+    long double _Complex long_double_a[COMPLEX_VALUES];
+    long double _Complex long_double_b[COMPLEX_VALUES];
+    long double _Complex long_double_r[COMPLEX_VALUES];
+#endif
+    volatile double sink;
+};
+
+/*
+ * The formulas use the parts of a complex number through its
+ * representation, which is the same as an array of two reals.
+ */
+#define DEFINE_COMPLEX_BENCH(name, real_type)                               \
+static void bench_complex_mul_default_##name(void *ctx, unsigned long n) {  \
+    struct complex_ctx *const c = ctx;                                      \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const size_t j = i % COMPLEX_VALUES;                                \
+        c->name##_r[j] = c->name##_a[j] * c->name##_b[j];                   \
+    }                                                                       \
+    c->sink = (double)(real_type)c->name##_r[0];                            \
+}                                                                           \
+static void bench_complex_div_default_##name(void *ctx, unsigned long n) {  \
+    struct complex_ctx *const c = ctx;                                      \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const size_t j = i % COMPLEX_VALUES;                                \
+        c->name##_r[j] = c->name##_a[j] / c->name##_b[j];                   \
+    }                                                                       \
+    c->sink = (double)(real_type)c->name##_r[0];                            \
+}                                                                           \
+DEFINE_COMPLEX_PRAGMA_BENCH(name, real_type)                                \
+static void bench_complex_mul_formula_##name(void *ctx, unsigned long n) {  \
+    struct complex_ctx *const c = ctx;                                      \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const size_t j = i % COMPLEX_VALUES;                                \
+        const real_type *const x = (const real_type *)&c->name##_a[j];      \
+        const real_type *const y = (const real_type *)&c->name##_b[j];      \
+        real_type *const r = (real_type *)&c->name##_r[j];                  \
+        r[0] = x[0] * y[0] - x[1] * y[1];                                   \
+        r[1] = x[0] * y[1] + x[1] * y[0];                                   \
+    }                                                                       \
+    c->sink = (double)(real_type)c->name##_r[0];                            \
+}                                                                           \
+static void bench_complex_div_formula_##name(void *ctx, unsigned long n) {  \
+    struct complex_ctx *const c = ctx;                                      \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const size_t j = i % COMPLEX_VALUES;                                \
+        const real_type *const x = (const real_type *)&c->name##_a[j];      \
+        const real_type *const y = (const real_type *)&c->name##_b[j];      \
+        real_type *const r = (real_type *)&c->name##_r[j];                  \
+        const real_type d = y[0] * y[0] + y[1] * y[1];                      \
+        r[0] = (x[0] * y[0] + x[1] * y[1]) / d;                             \
+        r[1] = (x[1] * y[0] - x[0] * y[1]) / d;                             \
+    }                                                                       \
+    c->sink = (double)(real_type)c->name##_r[0];                            \
+}                                                                           \
+static bool default_full_range_##name(void) {                               \
+    static volatile real_type parts[2][2] = { { 0, 0 }, { 1, 0 } };         \
+    real_type z[2], w[2], product[2];                                       \
+    real_type _Complex zc, wc, pc;                                          \
+    parts[0][0] = parts[0][1] = (real_type)HUGE_VAL;                        \
+    z[0] = parts[0][0]; z[1] = parts[0][1];                                 \
+    w[0] = parts[1][0]; w[1] = parts[1][1];                                 \
+    memcpy(&zc, z, sizeof zc);                                              \
+    memcpy(&wc, w, sizeof wc);                                              \
+    pc = zc * wc;                                                           \
+    memcpy(product, &pc, sizeof product);                                   \
+    return isinf(product[0]) || isinf(product[1]);                          \
+}
+
+#ifdef CX_LIMITED_RANGE_PRAGMA_HONORED
+#define DEFINE_COMPLEX_PRAGMA_BENCH(name, real_type)                        \
+static void bench_complex_mul_pragma_##name(void *ctx, unsigned long n) {   \
+    _Pragma("STDC CX_LIMITED_RANGE ON")                                     \
+    struct complex_ctx *const c = ctx;                                      \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const size_t j = i % COMPLEX_VALUES;                                \
+        c->name##_r[j] = c->name##_a[j] * c->name##_b[j];                   \
+    }                                                                       \
+    c->sink = (double)(real_type)c->name##_r[0];                            \
+}                                                                           \
+static void bench_complex_div_pragma_##name(void *ctx, unsigned long n) {   \
+    _Pragma("STDC CX_LIMITED_RANGE ON")                                     \
+    struct complex_ctx *const c = ctx;                                      \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        const size_t j = i % COMPLEX_VALUES;                                \
+        c->name##_r[j] = c->name##_a[j] / c->name##_b[j];                   \
+    }                                                                       \
+    c->sink = (double)(real_type)c->name##_r[0];                            \
+}
+#define COMPLEX_PRAGMA_BENCHES(name) bench_complex_mul_pragma_##name, bench_complex_div_pragma_##name
+#else
+#define DEFINE_COMPLEX_PRAGMA_BENCH(name, real_type)
+#define COMPLEX_PRAGMA_BENCHES(name) NULL, NULL
+#endif
+
+DEFINE_COMPLEX_BENCH(float, float)
+DEFINE_COMPLEX_BENCH(double, double)
+#ifdef LONG_DOUBLE_EXISTS
+DEFINE_COMPLEX_BENCH(long_double, long double)
+#endif
+
+struct complex_arith_type {
+    const char *type_name;
+    void (*fill)(struct complex_ctx *c);
+    bool (*full_range)(void);
+    bench_fn *benches[6];   /* mul, div for default, pragma, formula */
+};
+
+#define DEFINE_COMPLEX_FILL(name, real_type)                                \
+static void fill_complex_##name(struct complex_ctx *c) {                    \
+    uint_least64_t state = 40;                                              \
+    size_t i;                                                               \
+    for (i = 0; i < COMPLEX_VALUES; i ++) {                                 \
+        real_type *const x = (real_type *)&c->name##_a[i];                  \
+        real_type *const y = (real_type *)&c->name##_b[i];                  \
+        x[0] = (real_type)(0.5 + (double)(bench_random(&state) % 1000) / 1000.0); \
+        x[1] = (real_type)(0.5 + (double)(bench_random(&state) % 1000) / 1000.0); \
+        y[0] = (real_type)(0.5 + (double)(bench_random(&state) % 1000) / 1000.0); \
+        y[1] = (real_type)(0.5 + (double)(bench_random(&state) % 1000) / 1000.0); \
+    }                                                                       \
+}
+
+DEFINE_COMPLEX_FILL(float, float)
+DEFINE_COMPLEX_FILL(double, double)
+#ifdef LONG_DOUBLE_EXISTS
+DEFINE_COMPLEX_FILL(long_double, long double)
+#endif
+
+#define COMPLEX_ARITH_TYPE(type_name, name)                                 \
+    { type_name, fill_complex_##name, default_full_range_##name,            \
+      { bench_complex_mul_default_##name, bench_complex_div_default_##name, \
+        COMPLEX_PRAGMA_BENCHES(name),                                       \
+        bench_complex_mul_formula_##name, bench_complex_div_formula_##name } }
+
+static const struct complex_arith_type complex_arith_types[] = {
+    COMPLEX_ARITH_TYPE("float _Complex", float),
+    COMPLEX_ARITH_TYPE("double _Complex", double),
+#ifdef LONG_DOUBLE_EXISTS
+    COMPLEX_ARITH_TYPE("long double _Complex", long_double),
+#endif
+};
+
+static void show_complex_arithmetic(FILE *out) {
+    static const char *const ops[] = { "mul", "div" };
+    static const char *const methods[] = { "default", "pragma", "formula" };
+    struct complex_ctx *const c = malloc(sizeof *c);
+    size_t t;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[complex_arithmetic]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (t = 0; t < sizeof complex_arith_types / sizeof complex_arith_types[0]; t ++) {
+        const struct complex_arith_type *const ct = &complex_arith_types[t];
+        char name[NAME_SIZE];
+        int op;
+
+        space_to_hyphen(name, ct->type_name);
+        ct->fill(c);
+        fprintf(out, "    %s.default_full_range = %s\n", name, ct->full_range() ? "true" : "false");
+        for (op = 0; op < 2; op ++) {
+            double default_ns = 0.0;
+            int method;
+            for (method = 0; method < 3; method ++) {
+                bench_fn *const fn = ct->benches[2 * method + op];
+                struct measurement m;
+                char key[KEY_SIZE];
+                if (fn == NULL) {
+                    continue;
+                }
+                measure(fn, c, &m);
+                snprintf(key, sizeof key, "%s.%s.%s", name, ops[op], methods[method]);
+                show_ns(out, key, &m);
+                if (method == 0) {
+                    default_ns = m.ns_per_op;
+                }
+                else if (method == 2) {
+                    fprintf(out, "    %s.%s.formula_speedup = %.2f\n", name, ops[op], default_ns / m.ns_per_op);
+                }
+            }
+        }
+    }
+    putc('\n', out);
+    free(c);
+} /* show_complex_arithmetic */
+
+#endif /* COMPLEX_EXISTS */
+
+/*
+ * Loop index types.  The same loops are written with an int,
+ * unsigned, size_t and ptrdiff_t index: a strided loop that sums
+ * a[i * stride] (with a stride of 1, which compilers may vectorize,
+ * and 4), and a gather loop that sums a[index[i]] through an array of
+ * indexes of the same type.  The index type determines whether the
+ * compiler has to sign-extend it, or allow for it wrapping around,
+ * when it computes addresses.  Throughput is in millions of elements
+ * per second, and "relative" is relative to int.
+ */
+
+#define LOOP_ELEMENTS 65536
+
+struct loop_index_ctx {
+    const unsigned *data;
+    void *indexes;
+    volatile unsigned long count;
+    volatile unsigned long stride;
+    volatile unsigned sink;
+};
+
+#define DEFINE_LOOP_INDEX_BENCH(name, type)                                 \
+static void bench_loop_strided_##name(void *ctx, unsigned long n) {         \
+    struct loop_index_ctx *const c = ctx;                                   \
+    const unsigned *const a = c->data;                                      \
+    const type count = (type)c->count;                                      \
+    const type stride = (type)c->stride;                                    \
+    unsigned total = 0;                                                     \
+    unsigned long pass;                                                     \
+    for (pass = 0; pass < n; pass ++) {                                     \
+        type i;                                                             \
+        for (i = 0; i < count; i ++) {                                      \
+            total += a[i * stride];                                         \
+        }                                                                   \
+        bench_clobber();                                                    \
+    }                                                                       \
+    c->sink = total;                                                        \
+}                                                                           \
+static void bench_loop_gather_##name(void *ctx, unsigned long n) {          \
+    struct loop_index_ctx *const c = ctx;                                   \
+    const unsigned *const a = c->data;                                      \
+    const type *const index = c->indexes;                                   \
+    const type count = (type)c->count;                                      \
+    unsigned total = 0;                                                     \
+    unsigned long pass;                                                     \
+    for (pass = 0; pass < n; pass ++) {                                     \
+        type i;                                                             \
+        for (i = 0; i < count; i ++) {                                      \
+            total += a[index[i]];                                           \
+        }                                                                   \
+        bench_clobber();                                                    \
+    }                                                                       \
+    c->sink = total;                                                        \
+}                                                                           \
+static void fill_loop_indexes_##name(void *array, const unsigned long *values) { \
+    type *const index = array;                                              \
+    size_t i;                                                               \
+    for (i = 0; i < LOOP_ELEMENTS; i ++) {                                  \
+        index[i] = (type)values[i];                                         \
+    }                                                                       \
+}
+
+DEFINE_LOOP_INDEX_BENCH(int, int)
+DEFINE_LOOP_INDEX_BENCH(unsigned, unsigned)
+DEFINE_LOOP_INDEX_BENCH(size_t, size_t)
+DEFINE_LOOP_INDEX_BENCH(ptrdiff_t, ptrdiff_t)
+
+struct loop_index_type {
+    const char *name;
+    size_t size;
+    void (*fill)(void *array, const unsigned long *values);
+    bench_fn *strided;
+    bench_fn *gather;
+};
+
+#define LOOP_INDEX_TYPE(name) \
+    { #name, sizeof (name), fill_loop_indexes_##name, bench_loop_strided_##name, bench_loop_gather_##name }
+
+static const struct loop_index_type loop_index_types[] = {
+    LOOP_INDEX_TYPE(int),
+    LOOP_INDEX_TYPE(unsigned),
+    LOOP_INDEX_TYPE(size_t),
+    LOOP_INDEX_TYPE(ptrdiff_t)
+};
+
+static void show_loop_index(FILE *out) {
+    static const unsigned long strides[] = { 1, 4 };
+    enum { STRIDE_COUNT = sizeof strides / sizeof strides[0] };
+    unsigned *const data = malloc(LOOP_ELEMENTS * sizeof *data);
+    unsigned long *const values = malloc(LOOP_ELEMENTS * sizeof *values);
+    struct loop_index_ctx c;
+    double int_ns[STRIDE_COUNT + 1];
+    uint_least64_t state = 37;
+    size_t i;
+
+    c.indexes = malloc(LOOP_ELEMENTS * sizeof (size_t));
+    if (data == NULL || values == NULL || c.indexes == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < LOOP_ELEMENTS; i ++) {
+        data[i] = (unsigned)(bench_random(&state) & 0xffff);
+        values[i] = (unsigned long)(bench_random(&state) % LOOP_ELEMENTS);
+    }
+    c.data = data;
+
+    fputs("[loop_index]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    elements = %lu\n", (unsigned long)LOOP_ELEMENTS);
+    for (i = 0; i < sizeof loop_index_types / sizeof loop_index_types[0]; i ++) {
+        const struct loop_index_type *const t = &loop_index_types[i];
+        struct measurement m;
+        char key[KEY_SIZE];
+        size_t s;
+
+        fprintf(out, "    %s.size = %d\n", t->name, (int)(CHAR_BIT * t->size));
+        for (s = 0; s <= STRIDE_COUNT; s ++) {
+            if (s < STRIDE_COUNT) {
+                c.stride = strides[s];
+                c.count = LOOP_ELEMENTS / strides[s];
+                measure(t->strided, &c, &m);
+                snprintf(key, sizeof key, "%s.stride_%lu", t->name, strides[s]);
+            }
+            else {
+                t->fill(c.indexes, values);
+                c.count = LOOP_ELEMENTS;
+                measure(t->gather, &c, &m);
+                snprintf(key, sizeof key, "%s.gather", t->name);
+            }
+            /* One operation is a pass over c.count elements */
+            show_rate(out, key, "elements", &m, (double)c.count);
+            if (i == 0) {
+                int_ns[s] = m.ns_per_op;
+            }
+            fprintf(out, "    %s.relative = %.2f\n", key, int_ns[s] / m.ns_per_op);
+        }
+    }
+    putc('\n', out);
+    free(data);
+    free(values);
+    free(c.indexes);
+} /* show_loop_index */
+
+/*
+ * Checked arithmetic.  For each integer type, add, sub and mul are
+ * timed over arrays of operands with no overflow detection
+ * ("unchecked"), with __builtin_*_overflow() ("builtin") and C23
+ * ckd_*() ("ckd") where they exist, with hand-written checks against
+ * the type's limits before the operation ("precheck"), and by doing
+ * the operation in longest_signed or longest_unsigned and checking the
+ * result ("widen"; unsupported when there's no wider type).  The
+ * operands never overflow, so this is the cost of the checks on the
+ * normal path; note that the unchecked loops may be vectorized.
+ * "overhead" is the extra time relative to unchecked.
+ */
+
+#define CHECKED_VALUES 1024  /* must be a power of 2 */
+
+struct checked_ctx {
+    longest_unsigned x[CHECKED_VALUES];
+    longest_unsigned y[CHECKED_VALUES];
+    volatile longest_unsigned sink;
+};
+
+/*
+ * Each check sets overflow, and r if there was no overflow.
+ */
+#define CHECKED_KERNEL(name, type, opname, method, check)                   \
+static void bench_checked_##opname##_##method##_##name(void *ctx, unsigned long n) { \
+    struct checked_ctx *const c = ctx;                                      \
+    type x[CHECKED_VALUES];                                                 \
+    type y[CHECKED_VALUES];                                                 \
+    longest_unsigned total = 0;                                             \
+    unsigned long overflows = 0;                                            \
+    unsigned long i;                                                        \
+    for (i = 0; i < CHECKED_VALUES; i ++) {                                 \
+        x[i] = (type)c->x[i];                                               \
+        y[i] = (type)c->y[i];                                               \
+    }                                                                       \
+    for (i = 0; i < n; i ++) {                                              \
+        const type a = x[i % CHECKED_VALUES];                               \
+        const type b = y[i % CHECKED_VALUES];                               \
+        type r = 0;                                                         \
+        bool overflow;                                                      \
+        check                                                               \
+        if (overflow) {                                                     \
+            overflows ++;                                                   \
+        }                                                                   \
+        else {                                                              \
+            total += (longest_unsigned)r;                                   \
+        }                                                                   \
+    }                                                                       \
+    c->sink = total + overflows;                                            \
+}
+
+/* Pre-checks, for signed and unsigned types */
+#define PRECHECK_ADD_signed(a, b, min, max)   ((b) > 0 ? (a) > (max) - (b) : (a) < (min) - (b))
+#define PRECHECK_SUB_signed(a, b, min, max)   ((b) > 0 ? (a) < (min) + (b) : (a) > (max) + (b))
+#define PRECHECK_MUL_signed(a, b, min, max)                                 \
+    ((a) > 0 ? ((b) > 0 ? (a) > (max) / (b) : (b) < (min) / (a))           \
+             : ((b) > 0 ? (a) < (min) / (b) : (a) != 0 && (b) < (max) / (a)))
+#define PRECHECK_ADD_unsigned(a, b, min, max) ((a) > (max) - (b))
+#define PRECHECK_SUB_unsigned(a, b, min, max) ((a) < (b))
+#define PRECHECK_MUL_unsigned(a, b, min, max) ((b) != 0 && (a) > (max) / (b))
+
+/* Widening */
+#define WIDE_signed longest_signed
+#define WIDE_unsigned longest_unsigned
+#define WIDE_OVERFLOW_signed(w, min, max)   ((w) < (min) || (w) > (max))
+#define WIDE_OVERFLOW_unsigned(w, min, max) ((w) > (max))
+
+#define CHECKED_KERNELS(name, type, signedness, min, max, opname, OPNAME, op) \
+    CHECKED_KERNEL(name, type, opname, unchecked,                           \
+        { r = (type)(a op b); overflow = false; })                          \
+    CHECKED_BUILTIN_KERNEL(name, type, opname)                              \
+    CHECKED_CKD_KERNEL(name, type, opname)                                  \
+    CHECKED_KERNEL(name, type, opname, precheck,                            \
+        { overflow = PRECHECK_##OPNAME##_##signedness(a, b, min, max);      \
+          if (! overflow) r = (type)(a op b); })                            \
+    CHECKED_KERNEL(name, type, opname, widen,                               \
+        { const WIDE_##signedness w = (WIDE_##signedness)a op (WIDE_##signedness)b; \
+          overflow = WIDE_OVERFLOW_##signedness(w, min, max);               \
+          r = (type)w; })
+
+#ifdef OVERFLOW_BUILTINS_EXIST
+#define CHECKED_BUILTIN_KERNEL(name, type, opname)                          \
+    CHECKED_KERNEL(name, type, opname, builtin,                             \
+        { overflow = __builtin_##opname##_overflow(a, b, &r); })
+#define CHECKED_BUILTIN_BENCH(name, opname) bench_checked_##opname##_builtin_##name
+#else
+#define CHECKED_BUILTIN_KERNEL(name, type, opname)
+#define CHECKED_BUILTIN_BENCH(name, opname) NULL
+#endif
+
+#ifdef STDCKDINT_H_EXISTS
+#define CHECKED_CKD_KERNEL(name, type, opname)                              \
+    CHECKED_KERNEL(name, type, opname, ckd,                                 \
+        { overflow = ckd_##opname(&r, a, b); })
+#define CHECKED_CKD_BENCH(name, opname) bench_checked_##opname##_ckd_##name
+#else
+#define CHECKED_CKD_KERNEL(name, type, opname)
+#define CHECKED_CKD_BENCH(name, opname) NULL
+#endif
+
+/*
+ * The benches for each operation, in the order of checked_methods[].
+ */
+#define CHECKED_BENCHES(name, opname)                                       \
+    { bench_checked_##opname##_unchecked_##name,                            \
+      CHECKED_BUILTIN_BENCH(name, opname),                                  \
+      CHECKED_CKD_BENCH(name, opname),                                      \
+      bench_checked_##opname##_precheck_##name,                             \
+      bench_checked_##opname##_widen_##name }
+
+#define DEFINE_CHECKED_BENCH(name, type, signedness, min, max)              \
+    CHECKED_KERNELS(name, type, signedness, min, max, add, ADD, +)          \
+    CHECKED_KERNELS(name, type, signedness, min, max, sub, SUB, -)          \
+    CHECKED_KERNELS(name, type, signedness, min, max, mul, MUL, *)          \
+    static bench_fn *const checked_benches_##name[3][5] = {                 \
+        CHECKED_BENCHES(name, add),                                         \
+        CHECKED_BENCHES(name, sub),                                         \
+        CHECKED_BENCHES(name, mul)                                          \
+    };
+
+#ifdef SIGNED_CHAR_EXISTS
+DEFINE_CHECKED_BENCH(signed_char, signed char, signed, SCHAR_MIN, SCHAR_MAX)
+#endif
+DEFINE_CHECKED_BENCH(unsigned_char, unsigned char, unsigned, 0, UCHAR_MAX)
+DEFINE_CHECKED_BENCH(short, short, signed, SHRT_MIN, SHRT_MAX)
+DEFINE_CHECKED_BENCH(unsigned_short, unsigned short, unsigned, 0, USHRT_MAX)
+DEFINE_CHECKED_BENCH(int, int, signed, INT_MIN, INT_MAX)
+DEFINE_CHECKED_BENCH(unsigned, unsigned, unsigned, 0, UINT_MAX)
+DEFINE_CHECKED_BENCH(long, long, signed, LONG_MIN, LONG_MAX)
+DEFINE_CHECKED_BENCH(unsigned_long, unsigned long, unsigned, 0, ULONG_MAX)
+#ifdef LONG_LONG_EXISTS
+DEFINE_CHECKED_BENCH(long_long, long long, signed, MY_LLONG_MIN, MY_LLONG_MAX)
+DEFINE_CHECKED_BENCH(unsigned_long_long, unsigned long long, unsigned, 0, MY_ULLONG_MAX)
+#endif
+
+struct checked_type {
+    const char *type_name;
+    bench_fn *const (*benches)[5];
+    size_t size;
+    bool is_signed;
+    longest_unsigned max;
+};
+
+static const struct checked_type checked_types[] = {
+#ifdef SIGNED_CHAR_EXISTS
+    { "signed char",        checked_benches_signed_char,        sizeof (signed char),        true,  SCHAR_MAX },
+#endif
+    { "unsigned char",      checked_benches_unsigned_char,      sizeof (unsigned char),      false, UCHAR_MAX },
+    { "short",              checked_benches_short,              sizeof (short),              true,  SHRT_MAX },
+    { "unsigned short",     checked_benches_unsigned_short,     sizeof (unsigned short),     false, USHRT_MAX },
+    { "int",                checked_benches_int,                sizeof (int),                true,  INT_MAX },
+    { "unsigned",           checked_benches_unsigned,           sizeof (unsigned),           false, UINT_MAX },
+    { "long",               checked_benches_long,               sizeof (long),               true,  LONG_MAX },
+    { "unsigned long",      checked_benches_unsigned_long,      sizeof (unsigned long),      false, ULONG_MAX },
+#ifdef LONG_LONG_EXISTS
+    { "long long",          checked_benches_long_long,          sizeof (long long),          true,  MY_LLONG_MAX },
+    { "unsigned long long", checked_benches_unsigned_long_long, sizeof (unsigned long long), false, MY_ULLONG_MAX },
+#endif
+};
+
+static const char *const checked_methods[5] = { "unchecked", "builtin", "ckd", "precheck", "widen" };
+
+/*
+ * Fills c->x[] and c->y[] with operands for op (0 add, 1 sub, 2 mul)
+ * that don't overflow type t.  For mul, both operands are at most
+ * limit, where limit * limit <= max.
+ */
+static void fill_checked_operands(struct checked_ctx *c, const struct checked_type *t, int op) {
+    uint_least64_t state = 45;
+    longest_unsigned limit = t->max / 2;
+    size_t i;
+
+    if (op == 2) {
+        limit = 1;
+        while (limit <= t->max / limit / 4) {
+            limit *= 2;
+        }
+    }
+    for (i = 0; i < CHECKED_VALUES; i ++) {
+        longest_unsigned x = (longest_unsigned)bench_random(&state) % (limit + 1);
+        longest_unsigned y = (longest_unsigned)bench_random(&state) % (limit + 1);
+        if (t->is_signed) {
+            /* Values in [-limit, limit], stored modulo 2**N */
+            if (bench_random(&state) & 1) {
+                x = 0 - x;
+            }
+            if (bench_random(&state) & 1) {
+                y = 0 - y;
+            }
+        }
+        else if (op == 1) {
+            /* x - y with x >= y */
+            x += limit;
+        }
+        c->x[i] = x;
+        c->y[i] = y;
+    }
+} /* fill_checked_operands */
+
+static void show_checked_arithmetic(FILE *out) {
+    static const char *const ops[3] = { "add", "sub", "mul" };
+    struct checked_ctx *const c = malloc(sizeof *c);
+    size_t t;
+
+    if (c == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fputs("[checked_arithmetic]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (t = 0; t < sizeof checked_types / sizeof checked_types[0]; t ++) {
+        const struct checked_type *const ct = &checked_types[t];
+        char name[NAME_SIZE];
+        int op;
+
+        space_to_hyphen(name, ct->type_name);
+        for (op = 0; op < 3; op ++) {
+            /* Widening needs a type twice as wide for mul, wider for add and sub */
+            const bool widen_ok = op == 2 ? 2 * ct->size <= sizeof (longest_unsigned)
+                                          : ct->size < sizeof (longest_unsigned);
+            double unchecked_ns = 0.0;
+            int method;
+
+            fill_checked_operands(c, ct, op);
+            for (method = 0; method < 5; method ++) {
+                bench_fn *const fn = ct->benches[op][method];
+                struct measurement m;
+                char key[KEY_SIZE];
+
+                snprintf(key, sizeof key, "%s.%s.%s", name, ops[op], checked_methods[method]);
+                if (fn == NULL || (method == 4 && ! widen_ok)) {
+                    fprintf(out, "    %s = unsupported\n", key);
+                    continue;
+                }
+                measure(fn, c, &m);
+                show_ns(out, key, &m);
+                if (method == 0) {
+                    unchecked_ns = m.ns_per_op;
+                }
+                else {
+                    fprintf(out, "    %s.overhead = %.2f\n", key, m.ns_per_op / unchecked_ns - 1.0);
+                }
+            }
+        }
+    }
+    putc('\n', out);
+    free(c);
+} /* show_checked_arithmetic */
+
+/*
+ * Floating/integer conversions.  For each floating type and each
+ * integer type, a truncating cast from floating to integer and a cast
+ * from integer to floating are timed over an array of values spread
+ * over the integer type's range, so conversions to and from unsigned
+ * types take their slow paths about half the time.  lrint() (to long),
+ * llrint() and round() (to long long) are timed for each floating
+ * type too.  A conversion at least 5 times slower than the fastest
+ * equivalent (in the same direction, with the same integer type) is
+ * marked slow; these are typically calls to a runtime library routine.
+ */
+
+#define CONVERSION_VALUES 1024
+
+struct conversion_ctx {
+    long double floating[CONVERSION_VALUES];
+    longest_unsigned integers[CONVERSION_VALUES];
+    volatile long double sink;
+};
+
+/*
+ * Converts x (of from_type, taken from c->source) with expr, a pass
+ * over the values at a time.
+ */
+#define CONVERSION_KERNEL(name, from_type, to_type, source, expr)           \
+static void bench_conversion_##name(void *ctx, unsigned long n) {           \
+    struct conversion_ctx *const c = ctx;                                   \
+    from_type in[CONVERSION_VALUES];                                        \
+    to_type result[CONVERSION_VALUES];                                      \
+    unsigned long done;                                                     \
+    size_t i;                                                               \
+    for (i = 0; i < CONVERSION_VALUES; i ++) {                              \
+        in[i] = (from_type)c->source[i];                                    \
+        result[i] = 0;                                                      \
+    }                                                                       \
+    for (done = 0; done < n; done += CONVERSION_VALUES) {                   \
+        const size_t count = n - done < CONVERSION_VALUES ? (size_t)(n - done) : CONVERSION_VALUES; \
+        for (i = 0; i < count; i ++) {                                      \
+            const from_type x = in[i];                                      \
+            result[i] = expr;                                               \
+        }                                                                   \
+        bench_escape(result);                                               \
+    }                                                                       \
+    c->sink = (long double)result[0];                                       \
+}
+
+#define CONVERSION_PAIR(fname, ftype, iname, itype)                         \
+    CONVERSION_KERNEL(fname##_to_##iname, ftype, itype, floating, (itype)x) \
+    CONVERSION_KERNEL(iname##_to_##fname, itype, ftype, integers, (ftype)x)
+
+#define CONVERSION_ENTRY(fname, ftype, iname, itype, is_signed, max)        \
+    { #ftype, #itype, "cast", bench_conversion_##fname##_to_##iname,        \
+      bench_conversion_##iname##_to_##fname, is_signed, max }
+
+#ifdef LONG_DOUBLE_EXISTS
+#define LONG_DOUBLE_CONVERSION_PAIR(iname, itype) \
+    CONVERSION_PAIR(long_double, long double, iname, itype)
+#define LONG_DOUBLE_CONVERSION_ENTRY(iname, itype, is_signed, max) \
+    , CONVERSION_ENTRY(long_double, long double, iname, itype, is_signed, max)
+#else
+#define LONG_DOUBLE_CONVERSION_PAIR(iname, itype)
+#define LONG_DOUBLE_CONVERSION_ENTRY(iname, itype, is_signed, max)
+#endif
+
+#define DEFINE_CONVERSIONS(iname, itype)                                    \
+    CONVERSION_PAIR(float, float, iname, itype)                             \
+    CONVERSION_PAIR(double, double, iname, itype)                           \
+    LONG_DOUBLE_CONVERSION_PAIR(iname, itype)
+
+#define CONVERSION_ENTRIES(iname, itype, is_signed, max)                    \
+    CONVERSION_ENTRY(float, float, iname, itype, is_signed, max),           \
+    CONVERSION_ENTRY(double, double, iname, itype, is_signed, max)          \
+    LONG_DOUBLE_CONVERSION_ENTRY(iname, itype, is_signed, max)
+
+#ifdef SIGNED_CHAR_EXISTS
+DEFINE_CONVERSIONS(signed_char, signed char)
+#endif
+DEFINE_CONVERSIONS(unsigned_char, unsigned char)
+DEFINE_CONVERSIONS(short, short)
+DEFINE_CONVERSIONS(unsigned_short, unsigned short)
+DEFINE_CONVERSIONS(int, int)
+DEFINE_CONVERSIONS(unsigned, unsigned)
+DEFINE_CONVERSIONS(long, long)
+DEFINE_CONVERSIONS(unsigned_long, unsigned long)
+#ifdef LONG_LONG_EXISTS
+DEFINE_CONVERSIONS(long_long, long long)
+DEFINE_CONVERSIONS(unsigned_long_long, unsigned long long)
+#endif
+
+/* Rounding functions; NULL to_floating marks these */
+CONVERSION_KERNEL(float_lrint, float, long, floating, lrintf(x))
+CONVERSION_KERNEL(double_lrint, double, long, floating, lrint(x))
+#ifdef LONG_DOUBLE_EXISTS
+CONVERSION_KERNEL(long_double_lrint, long double, long, floating, lrintl(x))
+#endif
+#ifdef LONG_LONG_EXISTS
+CONVERSION_KERNEL(float_llrint, float, long long, floating, llrintf(x))
+CONVERSION_KERNEL(float_round, float, long long, floating, (long long)roundf(x))
+CONVERSION_KERNEL(double_llrint, double, long long, floating, llrint(x))
+CONVERSION_KERNEL(double_round, double, long long, floating, (long long)round(x))
+#ifdef LONG_DOUBLE_EXISTS
+CONVERSION_KERNEL(long_double_llrint, long double, long long, floating, llrintl(x))
+CONVERSION_KERNEL(long_double_round, long double, long long, floating, (long long)roundl(x))
+#endif
+#endif
+
+struct conversion {
+    const char *floating_name;
+    const char *integer_name;
+    const char *method;
+    bench_fn *to_integer;
+    bench_fn *to_floating;      /* NULL for rounding functions */
+    bool is_signed;
+    longest_unsigned max;
+};
+
+#define ROUNDING_ENTRY(fname, ftype, method, itype, max) \
+    { #ftype, #itype, #method, bench_conversion_##fname##_##method, NULL, true, max }
+
+static const struct conversion conversions[] = {
+#ifdef SIGNED_CHAR_EXISTS
+    CONVERSION_ENTRIES(signed_char, signed char, true, SCHAR_MAX),
+#endif
+    CONVERSION_ENTRIES(unsigned_char, unsigned char, false, UCHAR_MAX),
+    CONVERSION_ENTRIES(short, short, true, SHRT_MAX),
+    CONVERSION_ENTRIES(unsigned_short, unsigned short, false, USHRT_MAX),
+    CONVERSION_ENTRIES(int, int, true, INT_MAX),
+    CONVERSION_ENTRIES(unsigned, unsigned, false, UINT_MAX),
+    CONVERSION_ENTRIES(long, long, true, LONG_MAX),
+    CONVERSION_ENTRIES(unsigned_long, unsigned long, false, ULONG_MAX),
+#ifdef LONG_LONG_EXISTS
+    CONVERSION_ENTRIES(long_long, long long, true, MY_LLONG_MAX),
+    CONVERSION_ENTRIES(unsigned_long_long, unsigned long long, false, MY_ULLONG_MAX),
+#endif
+    ROUNDING_ENTRY(float, float, lrint, long, LONG_MAX),
+    ROUNDING_ENTRY(double, double, lrint, long, LONG_MAX),
+#ifdef LONG_DOUBLE_EXISTS
+    ROUNDING_ENTRY(long_double, long double, lrint, long, LONG_MAX),
+#endif
+#ifdef LONG_LONG_EXISTS
+    ROUNDING_ENTRY(float, float, llrint, long long, MY_LLONG_MAX),
+    ROUNDING_ENTRY(float, float, round, long long, MY_LLONG_MAX),
+    ROUNDING_ENTRY(double, double, llrint, long long, MY_LLONG_MAX),
+    ROUNDING_ENTRY(double, double, round, long long, MY_LLONG_MAX),
+#ifdef LONG_DOUBLE_EXISTS
+    ROUNDING_ENTRY(long_double, long double, llrint, long long, MY_LLONG_MAX),
+    ROUNDING_ENTRY(long_double, long double, round, long long, MY_LLONG_MAX),
+#endif
+#endif
+};
+
+#define CONVERSION_COUNT (sizeof conversions / sizeof conversions[0])
+
+/*
+ * Fills c with values for conversion v: floating values in (-max, max)
+ * (or [0, max) for unsigned types), short of max so that they're in
+ * range after rounding, and integers over the whole range.
+ */
+static void fill_conversion_values(struct conversion_ctx *c, const struct conversion *v) {
+    uint_least64_t state = 46;
+    size_t i;
+
+    for (i = 0; i < CONVERSION_VALUES; i ++) {
+        /* A fraction in [0, 1) with 53 significant bits */
+        const long double fraction = (long double)(bench_random(&state) >> 11) / 9007199254740992.0L;
+        const bool negative = v->is_signed && (bench_random(&state) & 1) != 0;
+        longest_unsigned x = (longest_unsigned)bench_random(&state);
+        c->floating[i] = fraction * (long double)v->max * 0.999L;
+        if (v->max < (longest_unsigned)-1) {
+            x %= v->max + 1;
+        }
+        if (negative) {
+            c->floating[i] = -c->floating[i];
+            x = 0 - x;
+        }
+        c->integers[i] = x;
+    }
+} /* fill_conversion_values */
+
+static void show_floating_conversion(FILE *out) {
+    struct conversion_ctx *const c = malloc(sizeof *c);
+    /* [i][0] is to integer, [i][1] to floating */
+    struct measurement (*const m)[2] = malloc(CONVERSION_COUNT * sizeof *m);
+    size_t i, j;
+    int dir;
+
+    if (c == NULL || m == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < CONVERSION_COUNT; i ++) {
+        const struct conversion *const v = &conversions[i];
+        fill_conversion_values(c, v);
+        for (dir = 0; dir < 2; dir ++) {
+            bench_fn *const fn = dir == 0 ? v->to_integer : v->to_floating;
+            if (fn != NULL) {
+                measure(fn, c, &m[i][dir]);
+            }
+        }
+    }
+
+    fputs("[floating_conversion]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (i = 0; i < CONVERSION_COUNT; i ++) {
+        const struct conversion *const v = &conversions[i];
+        char floating_name[NAME_SIZE];
+        char integer_name[NAME_SIZE];
+        space_to_hyphen(floating_name, v->floating_name);
+        space_to_hyphen(integer_name, v->integer_name);
+        for (dir = 0; dir < 2; dir ++) {
+            double fastest = m[i][dir].ns_per_op;
+            char key[KEY_SIZE];
+            if ((dir == 0 ? v->to_integer : v->to_floating) == NULL) {
+                continue;
+            }
+            /* The fastest conversion in the same direction with the same integer type */
+            for (j = 0; j < CONVERSION_COUNT; j ++) {
+                if ((dir == 0 ? conversions[j].to_integer : conversions[j].to_floating) != NULL &&
+                    strcmp(conversions[j].integer_name, v->integer_name) == 0 &&
+                    m[j][dir].ns_per_op < fastest)
+                {
+                    fastest = m[j][dir].ns_per_op;
+                }
+            }
+            if (dir == 0) {
+                snprintf(key, sizeof key, "%s.to.%s.%s", floating_name, integer_name, v->method);
+            }
+            else {
+                snprintf(key, sizeof key, "%s.to.%s.%s", integer_name, floating_name, v->method);
+            }
+            show_ns(out, key, &m[i][dir]);
+            fprintf(out, "    %s.values_per_ns = %.3f\n", key, 1.0 / m[i][dir].ns_per_op);
+            fprintf(out, "    %s.slow = %s\n", key,
+                    m[i][dir].ns_per_op >= 5.0 * fastest ? "true" : "false");
+        }
+    }
+    putc('\n', out);
+    free(c);
+    free(m);
+} /* show_floating_conversion */
+
+/*
+ * Sorting and searching.  For each integer and floating type, qsort()
+ * and bsearch() with a comparison callback are timed next to a sort
+ * (quicksort with a median-of-3 pivot, finished by insertion sort) and
+ * a binary search written for the type, on arrays of 1000 to
+ * SORT_MAX_ELEMENTS pseudo-random values.  Each sort starts from a
+ * copy of the same unsorted array; the copy is included in the time.
+ * Searches look up values present in the array, and like bsearch()
+ * stop at the first match they find.  "callback_tax" is the
+ * time with the library function divided by the time with the
+ * type-specific code.  SORT_MAX_ELEMENTS defaults to 10**6 to keep the
+ * run time reasonable; -DSORT_MAX_ELEMENTS=10000000 adds 10**7.
+ */
+
+#ifndef SORT_MAX_ELEMENTS
+#define SORT_MAX_ELEMENTS 1000000
+#endif
+#define SEARCH_KEYS 4096  /* must be a power of 2 */
+
+struct sort_ctx {
+    const void *unsorted;
+    void *work;                 /* sorted after a sort benchmark */
+    const void *keys;
+    size_t count;
+    volatile size_t sink;
+};
+
+#define DEFINE_SORT_BENCH(name, type)                                       \
+static int compare_##name(const void *a, const void *b) {                   \
+    const type x = *(const type *)a;                                        \
+    const type y = *(const type *)b;                                        \
+    return (x > y) - (x < y);                                               \
+}                                                                           \
+static void sort_##name(type *a, size_t count) {                            \
+    while (count > 16) {                                                    \
+        const size_t mid = count / 2;                                       \
+        size_t median;                                                      \
+        size_t i, j;                                                        \
+        type pivot, t;                                                      \
+        /* Move the median of the first, middle and last to the front */   \
+        if (a[0] < a[mid]) {                                                \
+            median = a[mid] < a[count - 1] ? mid : a[0] < a[count - 1] ? count - 1 : 0; \
+        }                                                                   \
+        else {                                                              \
+            median = a[0] < a[count - 1] ? 0 : a[mid] < a[count - 1] ? count - 1 : mid; \
+        }                                                                   \
+        t = a[0]; a[0] = a[median]; a[median] = t;                          \
+        pivot = a[0];                                                       \
+        /* Hoare partition: a[0..j] <= pivot <= a[j+1..count-1] */          \
+        i = 0;                                                              \
+        j = count - 1;                                                      \
+        for (;;) {                                                          \
+            while (pivot < a[j]) {                                          \
+                j --;                                                       \
+            }                                                               \
+            while (a[i] < pivot) {                                          \
+                i ++;                                                       \
+            }                                                               \
+            if (i >= j) {                                                   \
+                break;                                                      \
+            }                                                               \
+            t = a[i]; a[i] = a[j]; a[j] = t;                                \
+            i ++;                                                           \
+            j --;                                                           \
+        }                                                                   \
+        /* Recurse on the smaller part, loop on the larger */               \
+        if (j + 1 < count - j - 1) {                                        \
+            sort_##name(a, j + 1);                                          \
+            a += j + 1;                                                     \
+            count -= j + 1;                                                 \
+        }                                                                   \
+        else {                                                              \
+            sort_##name(a + j + 1, count - j - 1);                          \
+            count = j + 1;                                                  \
+        }                                                                   \
+    }                                                                       \
+    if (count > 1) {                                                        \
+        size_t i;                                                           \
+        for (i = 1; i < count; i ++) {                                      \
+            const type x = a[i];                                            \
+            size_t j = i;                                                   \
+            for (; j > 0 && x < a[j - 1]; j --) {                           \
+                a[j] = a[j - 1];                                            \
+            }                                                               \
+            a[j] = x;                                                       \
+        }                                                                   \
+    }                                                                       \
+}                                                                           \
+static const type *search_##name(const type *a, size_t count, type key) {   \
+    size_t lo = 0;                                                          \
+    size_t hi = count;                                                      \
+    while (lo < hi) {                                                       \
+        const size_t mid = lo + (hi - lo) / 2;                              \
+        if (a[mid] < key) {                                                 \
+            lo = mid + 1;                                                   \
+        }                                                                   \
+        else if (key < a[mid]) {                                            \
+            hi = mid;                                                       \
+        }                                                                   \
+        else {                                                              \
+            return &a[mid];                                                 \
+        }                                                                   \
+    }                                                                       \
+    return NULL;                                                            \
+}                                                                           \
+static void bench_qsort_##name(void *ctx, unsigned long n) {                \
+    struct sort_ctx *const c = ctx;                                         \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        memcpy(c->work, c->unsorted, c->count * sizeof (type));             \
+        qsort(c->work, c->count, sizeof (type), compare_##name);            \
+    }                                                                       \
+    c->sink = (size_t)((type *)c->work)[0];                                 \
+}                                                                           \
+static void bench_sort_##name(void *ctx, unsigned long n) {                 \
+    struct sort_ctx *const c = ctx;                                         \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        memcpy(c->work, c->unsorted, c->count * sizeof (type));             \
+        sort_##name(c->work, c->count);                                     \
+    }                                                                       \
+    c->sink = (size_t)((type *)c->work)[0];                                 \
+}                                                                           \
+static void bench_bsearch_##name(void *ctx, unsigned long n) {              \
+    struct sort_ctx *const c = ctx;                                         \
+    const type *const keys = c->keys;                                       \
+    size_t found = 0;                                                       \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        found += bsearch(&keys[i % SEARCH_KEYS], c->work, c->count,         \
+                         sizeof (type), compare_##name) != NULL;            \
+    }                                                                       \
+    c->sink = found;                                                        \
+}                                                                           \
+static void bench_search_##name(void *ctx, unsigned long n) {               \
+    struct sort_ctx *const c = ctx;                                         \
+    const type *const keys = c->keys;                                       \
+    size_t found = 0;                                                       \
+    unsigned long i;                                                        \
+    for (i = 0; i < n; i ++) {                                              \
+        found += search_##name(c->work, c->count, keys[i % SEARCH_KEYS]) != NULL; \
+    }                                                                       \
+    c->sink = found;                                                        \
+}                                                                           \
+static void fill_unsorted_##name(void *array, size_t count) {               \
+    type *const a = array;                                                  \
+    uint_least64_t state = 47;                                              \
+    size_t i;                                                               \
+    for (i = 0; i < count; i ++) {                                          \
+        a[i] = (type)bench_random(&state);                                  \
+    }                                                                       \
+}                                                                           \
+static void fill_keys_##name(void *keys, const void *sorted, size_t count) { \
+    type *const k = keys;                                                   \
+    const type *const a = sorted;                                           \
+    uint_least64_t state = 47;                                              \
+    size_t i;                                                               \
+    for (i = 0; i < SEARCH_KEYS; i ++) {                                    \
+        k[i] = a[bench_random(&state) % count];                             \
+    }                                                                       \
+}
+
+#ifdef SIGNED_CHAR_EXISTS
+DEFINE_SORT_BENCH(signed_char, signed char)
+#endif
+DEFINE_SORT_BENCH(unsigned_char, unsigned char)
+DEFINE_SORT_BENCH(short, short)
+DEFINE_SORT_BENCH(unsigned_short, unsigned short)
+DEFINE_SORT_BENCH(int, int)
+DEFINE_SORT_BENCH(unsigned, unsigned)
+DEFINE_SORT_BENCH(long, long)
+DEFINE_SORT_BENCH(unsigned_long, unsigned long)
+#ifdef LONG_LONG_EXISTS
+DEFINE_SORT_BENCH(long_long, long long)
+DEFINE_SORT_BENCH(unsigned_long_long, unsigned long long)
+#endif
+DEFINE_SORT_BENCH(float, float)
+DEFINE_SORT_BENCH(double, double)
+#ifdef LONG_DOUBLE_EXISTS
+DEFINE_SORT_BENCH(long_double, long double)
+#endif
+
+struct sort_type {
+    const char *type_name;
+    size_t size;
+    void (*fill_unsorted)(void *array, size_t count);
+    void (*fill_keys)(void *keys, const void *sorted, size_t count);
+    bench_fn *qsort;
+    bench_fn *sort;
+    bench_fn *bsearch;
+    bench_fn *search;
+};
+
+#define SORT_TYPE(name, type) \
+    { #type, sizeof (type), fill_unsorted_##name, fill_keys_##name, \
+      bench_qsort_##name, bench_sort_##name, bench_bsearch_##name, bench_search_##name }
+
+static const struct sort_type sort_types[] = {
+#ifdef SIGNED_CHAR_EXISTS
+    SORT_TYPE(signed_char, signed char),
+#endif
+    SORT_TYPE(unsigned_char, unsigned char),
+    SORT_TYPE(short, short),
+    SORT_TYPE(unsigned_short, unsigned short),
+    SORT_TYPE(int, int),
+    SORT_TYPE(unsigned, unsigned),
+    SORT_TYPE(long, long),
+    SORT_TYPE(unsigned_long, unsigned long),
+#ifdef LONG_LONG_EXISTS
+    SORT_TYPE(long_long, long long),
+    SORT_TYPE(unsigned_long_long, unsigned long long),
+#endif
+    SORT_TYPE(float, float),
+    SORT_TYPE(double, double),
+#ifdef LONG_DOUBLE_EXISTS
+    SORT_TYPE(long_double, long double),
+#endif
+};
+
+static void show_sort_search(FILE *out) {
+    /* Big enough for any of the types */
+    const size_t max_size = SORT_MAX_ELEMENTS * sizeof (long double);
+    void *const unsorted = malloc(max_size);
+    void *const work = malloc(max_size);
+    void *const keys = malloc(SEARCH_KEYS * sizeof (long double));
+    struct sort_ctx c;
+    size_t t;
+
+    if (unsorted == NULL || work == NULL || keys == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    c.unsorted = unsorted;
+    c.work = work;
+    c.keys = keys;
+
+    fputs("[sort_search]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (t = 0; t < sizeof sort_types / sizeof sort_types[0]; t ++) {
+        const struct sort_type *const st = &sort_types[t];
+        char name[NAME_SIZE];
+        unsigned long count;
+
+        space_to_hyphen(name, st->type_name);
+        st->fill_unsorted(unsorted, SORT_MAX_ELEMENTS);
+        for (count = 1000; count <= SORT_MAX_ELEMENTS; count *= 10) {
+            struct measurement library, specialized;
+            char key[KEY_SIZE];
+
+            c.count = count;
+            measure(st->qsort, &c, &library);
+            measure(st->sort, &c, &specialized);
+            snprintf(key, sizeof key, "%s.%lu.qsort", name, count);
+            show_rate(out, key, "elements", &library, (double)count);
+            snprintf(key, sizeof key, "%s.%lu.sort", name, count);
+            show_rate(out, key, "elements", &specialized, (double)count);
+            fprintf(out, "    %s.%lu.sort.callback_tax = %.2f\n", name, count,
+                    library.ns_per_op / specialized.ns_per_op);
+
+            /* c.work is now sorted */
+            st->fill_keys(keys, work, count);
+            measure(st->bsearch, &c, &library);
+            measure(st->search, &c, &specialized);
+            snprintf(key, sizeof key, "%s.%lu.bsearch", name, count);
+            show_ns(out, key, &library);
+            snprintf(key, sizeof key, "%s.%lu.search", name, count);
+            show_ns(out, key, &specialized);
+            fprintf(out, "    %s.%lu.search.callback_tax = %.2f\n", name, count,
+                    library.ns_per_op / specialized.ns_per_op);
+        }
+    }
+    putc('\n', out);
+    free(unsorted);
+    free(work);
+    free(keys);
+} /* show_sort_search */
+
+/*
+ * Extended integers.  add, mul and div are timed as dependent chains
+ * (so this is latency, not throughput) for the 64-bit types, for
+ * __int128 and _BitInt(128) where they exist, and for a pair of
+ * uint64_t ("uint64_t-pair") with hand-written carry propagation and
+ * partial products, which is what code without a 128-bit type does.
+ * Operands use the full width of the type; the divisor is small.  The
+ * chains are unrolled EXTENDED_UNROLL times, and the running value is
+ * passed through bench_launder() after each operation so that the
+ * chain can't be reassociated or reduced to a closed form; that adds
+ * no instructions, so the time is that of the operation itself.  The
+ * signed types are only timed for div, since their add and mul are the
+ * same operations as unsigned.  "relative" is the time relative to
+ * uint64_t, or int64_t for signed types.
+ */
+
+#define EXTENDED_UNROLL 8
+
+struct extended_ctx {
+    uint64_t x_hi, x_lo;        /* first operand */
+    uint64_t y_hi, y_lo;        /* second operand for add and mul */
+    uint64_t divisor;
+    volatile uint64_t sink;
+};
+
+/*
+ * A value of an unsigned type made from two 64-bit halves, truncated
+ * for types narrower than 128 bits.
+ */
+#define EXTENDED_VALUE(utype, hi, lo) \
+    ((utype)((utype)(hi) << (sizeof (utype) * CHAR_BIT / 2) ^ (utype)(lo)))
+
+/*
+ * Runs step n times, EXTENDED_UNROLL at a time.
+ */
+#define EXTENDED_CHAIN(n, step)                                             \
+    do {                                                                    \
+        unsigned long i;                                                    \
+        for (i = 0; i + EXTENDED_UNROLL <= (n); i += EXTENDED_UNROLL) {     \
+            step step step step step step step step                         \
+        }                                                                   \
+        for (; i < (n); i ++) {                                             \
+            step                                                            \
+        }                                                                   \
+    } while (0)
+
+#define DEFINE_EXTENDED_UNSIGNED_BENCH(name, utype)                         \
+static void bench_extended_add_##name(void *ctx, unsigned long n) {         \
+    struct extended_ctx *const c = ctx;                                     \
+    utype y = EXTENDED_VALUE(utype, c->y_hi, c->y_lo);                      \
+    utype x = EXTENDED_VALUE(utype, c->x_hi, c->x_lo);                      \
+    bench_launder(y);                                                       \
+    EXTENDED_CHAIN(n, { x += y; bench_launder(x); });                       \
+    c->sink = (uint64_t)x;                                                  \
+}                                                                           \
+static void bench_extended_mul_##name(void *ctx, unsigned long n) {         \
+    struct extended_ctx *const c = ctx;                                     \
+    utype y = EXTENDED_VALUE(utype, c->y_hi, c->y_lo);                      \
+    utype x = EXTENDED_VALUE(utype, c->x_hi, c->x_lo);                      \
+    bench_launder(y);                                                       \
+    EXTENDED_CHAIN(n, { x *= y; bench_launder(x); });                       \
+    c->sink = (uint64_t)x;                                                  \
+}
+
+/*
+ * x stays non-negative: x / d + addend is at most max / 2 + max / 4.
+ */
+#define DEFINE_EXTENDED_DIV_BENCH(name, type, utype)                        \
+static void bench_extended_div_##name(void *ctx, unsigned long n) {         \
+    struct extended_ctx *const c = ctx;                                     \
+    const type d = (type)c->divisor;                                        \
+    const type addend = (type)((utype)-1 >> 2);                             \
+    type x = (type)(EXTENDED_VALUE(utype, c->x_hi, c->x_lo) >> 1);          \
+    EXTENDED_CHAIN(n, { x = x / d + addend; });                             \
+    c->sink = (uint64_t)x;                                                  \
+}
+
+DEFINE_EXTENDED_UNSIGNED_BENCH(uint64, uint64_t)
+DEFINE_EXTENDED_DIV_BENCH(uint64, uint64_t, uint64_t)
+DEFINE_EXTENDED_DIV_BENCH(int64, int64_t, uint64_t)
+#ifdef INT128_EXISTS
+DEFINE_EXTENDED_UNSIGNED_BENCH(uint128, uint128)
+DEFINE_EXTENDED_DIV_BENCH(uint128, uint128, uint128)
+DEFINE_EXTENDED_DIV_BENCH(int128, int128, uint128)
+#endif
+#ifdef BITINT_128_EXISTS
+DEFINE_EXTENDED_UNSIGNED_BENCH(ubitint_128, ubitint_128)
+DEFINE_EXTENDED_DIV_BENCH(ubitint_128, ubitint_128, ubitint_128)
+DEFINE_EXTENDED_DIV_BENCH(bitint_128, bitint_128, ubitint_128)
+#endif
+
+static void bench_extended_add_pair(void *ctx, unsigned long n) {
+    struct extended_ctx *const c = ctx;
+    uint64_t y_hi = c->y_hi;
+    uint64_t y_lo = c->y_lo;
+    uint64_t hi = c->x_hi;
+    uint64_t lo = c->x_lo;
+
+    bench_launder(y_hi);
+    bench_launder(y_lo);
+    EXTENDED_CHAIN(n, {
+        lo += y_lo;
+        hi += y_hi + (lo < y_lo);
+        bench_launder(lo);
+        bench_launder(hi);
+    });
+    c->sink = hi ^ lo;
+}
+
+/*
+ * The low 128 bits of the product: the full 128-bit product of the low
+ * halves, from 32-bit partial products, plus the cross products in the
+ * high half.
+ */
+static void bench_extended_mul_pair(void *ctx, unsigned long n) {
+    const uint64_t mask = 0xffffffff;
+    struct extended_ctx *const c = ctx;
+    uint64_t y_hi = c->y_hi;
+    uint64_t y_lo = c->y_lo;
+    uint64_t hi = c->x_hi;
+    uint64_t lo = c->x_lo;
+
+    bench_launder(y_hi);
+    bench_launder(y_lo);
+    EXTENDED_CHAIN(n, {
+        const uint64_t p00 = (lo & mask) * (y_lo & mask);
+        const uint64_t p01 = (lo & mask) * (y_lo >> 32);
+        const uint64_t p10 = (lo >> 32) * (y_lo & mask);
+        const uint64_t p11 = (lo >> 32) * (y_lo >> 32);
+        const uint64_t mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+        hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32) + hi * y_lo + lo * y_hi;
+        lo = (mid << 32) | (p00 & mask);
+        bench_launder(lo);
+        bench_launder(hi);
+    });
+    c->sink = hi ^ lo;
+}
+
+struct extended_type {
+    const char *type_name;
+    bool is_signed;
+    bench_fn *benches[3];       /* add, mul, div; NULL if not timed */
+};
+
+static const struct extended_type extended_types[] = {
+    { "uint64_t",              false, { bench_extended_add_uint64, bench_extended_mul_uint64, bench_extended_div_uint64 } },
+    { "int64_t",               true,  { NULL, NULL, bench_extended_div_int64 } },
+    { "uint64_t pair",         false, { bench_extended_add_pair, bench_extended_mul_pair, NULL } },
+#ifdef INT128_EXISTS
+    { "unsigned __int128",     false, { bench_extended_add_uint128, bench_extended_mul_uint128, bench_extended_div_uint128 } },
+    { "__int128",              true,  { NULL, NULL, bench_extended_div_int128 } },
+#endif
+#ifdef BITINT_128_EXISTS
+    { "unsigned _BitInt(128)", false, { bench_extended_add_ubitint_128, bench_extended_mul_ubitint_128, bench_extended_div_ubitint_128 } },
+    { "_BitInt(128)",          true,  { NULL, NULL, bench_extended_div_bitint_128 } },
+#endif
+};
+
+static void show_extended_integers(FILE *out) {
+    static const char *const ops[3] = { "add", "mul", "div" };
+    struct extended_ctx c;
+    double baseline_ns[2][3];   /* [is_signed][op] */
+    size_t t;
+    int op;
+
+    c.x_hi = 0x9e3779b97f4a7c15U;
+    c.x_lo = 0xbf58476d1ce4e5b9U;
+    c.y_hi = 0x94d049bb133111ebU;
+    c.y_lo = 0x2545f4914f6cdd1dU;    /* odd, so x * y never becomes 0 */
+    c.divisor = 7;
+    for (op = 0; op < 3; op ++) {
+        baseline_ns[0][op] = baseline_ns[1][op] = 0.0;
+    }
+
+    fputs("[extended_integers]\n", out);
+    fputs("    kind = measurement\n", out);
+    for (t = 0; t < sizeof extended_types / sizeof extended_types[0]; t ++) {
+        const struct extended_type *const et = &extended_types[t];
+        char name[NAME_SIZE];
+
+        space_to_hyphen(name, et->type_name);
+        for (op = 0; op < 3; op ++) {
+            double *const baseline = &baseline_ns[et->is_signed][op];
+            struct measurement m;
+            char key[KEY_SIZE];
+
+            snprintf(key, sizeof key, "%s.%s", name, ops[op]);
+            if (et->benches[op] == NULL) {
+                if (! et->is_signed) {
+                    fprintf(out, "    %s = unsupported\n", key);
+                }
+                continue;
+            }
+            measure(et->benches[op], &c, &m);
+            show_ns(out, key, &m);
+            if (*baseline == 0.0) {
+                *baseline = m.ns_per_op;
+            }
+            else {
+                fprintf(out, "    %s.relative = %.2f\n", key, m.ns_per_op / *baseline);
+            }
+        }
+    }
+    putc('\n', out);
+} /* show_extended_integers */
+
+/*
+ * Half precision.  For float and each 16-bit floating type, arrays of
+ * HALF_ELEMENTS values are converted to float ("to_float") and from
+ * float ("from_float"), and y[i] = a * x[i] + y[i] is computed in the
+ * type itself ("axpy"; the compiler may do the arithmetic in float
+ * where there's no 16-bit hardware).  The arrays are bigger than most
+ * caches, so for float these are limited by memory traffic; "relative"
+ * is the speed relative to float, so values near 2 mean that 16-bit
+ * storage halves the traffic without a conversion bottleneck.
+ */
+
+#ifndef HALF_ELEMENTS
+#define HALF_ELEMENTS (4UL * 1024 * 1024)
+#endif
+
+struct half_ctx {
+    const float *f;             /* source for from_float */
+    float *g;                   /* destination for to_float */
+    void *x;                    /* HALF_ELEMENTS values of the type */
+    void *y;
+    volatile float a;
+};
+
+#define DEFINE_HALF_BENCH(name, type)                                       \
+static void bench_half_to_float_##name(void *ctx, unsigned long n) {        \
+    struct half_ctx *const c = ctx;                                         \
+    const type *const x = c->x;                                             \
+    float *const g = c->g;                                                  \
+    unsigned long pass;                                                     \
+    for (pass = 0; pass < n; pass ++) {                                     \
+        unsigned long i;                                                    \
+        for (i = 0; i < HALF_ELEMENTS; i ++) {                              \
+            g[i] = (float)x[i];                                             \
+        }                                                                   \
+        bench_clobber();                                                    \
+    }                                                                       \
+}                                                                           \
+static void bench_half_from_float_##name(void *ctx, unsigned long n) {      \
+    struct half_ctx *const c = ctx;                                         \
+    const float *const f = c->f;                                            \
+    type *const x = c->x;                                                   \
+    unsigned long pass;                                                     \
+    for (pass = 0; pass < n; pass ++) {                                     \
+        unsigned long i;                                                    \
+        for (i = 0; i < HALF_ELEMENTS; i ++) {                              \
+            x[i] = (type)f[i];                                              \
+        }                                                                   \
+        bench_clobber();                                                    \
+    }                                                                       \
+}                                                                           \
+static void bench_half_axpy_##name(void *ctx, unsigned long n) {            \
+    struct half_ctx *const c = ctx;                                         \
+    const type a = (type)c->a;                                              \
+    const type *const x = c->x;                                             \
+    type *const y = c->y;                                                   \
+    unsigned long pass;                                                     \
+    for (pass = 0; pass < n; pass ++) {                                     \
+        unsigned long i;                                                    \
+        for (i = 0; i < HALF_ELEMENTS; i ++) {                              \
+            y[i] = (type)(a * x[i] + y[i]);                                 \
+        }                                                                   \
+        bench_clobber();                                                    \
+    }                                                                       \
+}
+
+DEFINE_HALF_BENCH(float, float)
+#ifdef FLOAT16_EXISTS
+DEFINE_HALF_BENCH(float_16, float_16)
+#endif
+#ifdef BF16_EXISTS
+DEFINE_HALF_BENCH(bfloat_16, bfloat_16)
+#endif
+
+#define HALF_BENCHES(name) \
+    bench_half_to_float_##name, bench_half_from_float_##name, bench_half_axpy_##name
+
+struct half_type {
+    const char *type_name;
+    size_t size;
+    bench_fn *to_float;
+    bench_fn *from_float;
+    bench_fn *axpy;
+};
+
+static const struct half_type half_types[] = {
+    { "float",    sizeof (float),     HALF_BENCHES(float) },
+#ifdef FLOAT16_EXISTS
+    { "_Float16", sizeof (float_16),  HALF_BENCHES(float_16) },
+#endif
+#ifdef BF16_EXISTS
+    { "__bf16",   sizeof (bfloat_16), HALF_BENCHES(bfloat_16) },
+#endif
+};
+
+static void show_half_precision(FILE *out) {
+    static const char *const ops[3] = { "to_float", "from_float", "axpy" };
+    float *const f = malloc(HALF_ELEMENTS * sizeof *f);
+    float *const g = malloc(HALF_ELEMENTS * sizeof *g);
+    /* Big enough for any of the types */
+    void *const x = malloc(HALF_ELEMENTS * sizeof (float));
+    void *const y = malloc(HALF_ELEMENTS * sizeof (float));
+    uint_least64_t state = 49;
+    double float_ns[3];
+    struct half_ctx c;
+    size_t t;
+    unsigned long i;
+
+    if (f == NULL || g == NULL || x == NULL || y == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    /* Values in [-1, 1), which all the types can represent closely */
+    for (i = 0; i < HALF_ELEMENTS; i ++) {
+        f[i] = (float)((double)(bench_random(&state) >> 11) / 4503599627370496.0 - 1.0);
+    }
+    c.f = f;
+    c.g = g;
+    c.x = x;
+    c.y = y;
+    c.a = 1.0F / 1024;
+
+    fputs("[half_precision]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    elements = %lu\n", (unsigned long)HALF_ELEMENTS);
+    for (t = 0; t < sizeof half_types / sizeof half_types[0]; t ++) {
+        const struct half_type *const ht = &half_types[t];
+        bench_fn *const benches[3] = { ht->to_float, ht->from_float, ht->axpy };
+        char name[NAME_SIZE];
+        int op;
+
+        space_to_hyphen(name, ht->type_name);
+        fprintf(out, "    %s.size = %d\n", name, (int)(CHAR_BIT * ht->size));
+        /* x and y hold the values of f in this type */
+        ht->from_float(&c, 1);
+        memcpy(y, x, HALF_ELEMENTS * ht->size);
+        for (op = 0; op < 3; op ++) {
+            struct measurement m;
+            char key[KEY_SIZE];
+
+            measure(benches[op], &c, &m);
+            snprintf(key, sizeof key, "%s.%s", name, ops[op]);
+            /* One operation is a pass over the arrays */
+            show_rate(out, key, "elements", &m, (double)HALF_ELEMENTS);
+            if (t == 0) {
+                float_ns[op] = m.ns_per_op;
+            }
+            else {
+                fprintf(out, "    %s.relative = %.2f\n", key, float_ns[op] / m.ns_per_op);
+            }
+        }
+    }
+    putc('\n', out);
+    free(f);
+    free(g);
+    free(x);
+    free(y);
+} /* show_half_precision */
+
+/*
+ * Pointer chasing.  A circular linked list of POINTER_NODES nodes,
+ * linked in a random order so that once it's bigger than the caches
+ * most steps are cache misses, is traversed ("list.traverse", per
+ * node), and a balanced binary search tree of as many nodes, also in a
+ * random order in memory, is searched for random keys ("tree.lookup",
+ * per lookup).  The node sizes, and so the footprint and the number of
+ * nodes per cache line, depend on the sizes of pointers and long;
+ * "make abi-report" compares them across ABIs such as -m64, -mx32 and
+ * -m32.
+ */
+
+#ifndef POINTER_NODES
+#define POINTER_NODES (1024UL * 1024)
+#endif
+
+struct list_node {
+    struct list_node *next;
+    long value;
+};
+
+struct tree_node {
+    struct tree_node *left;
+    struct tree_node *right;
+    long key;
+};
+
+struct pointer_ctx {
+    const struct list_node *cursor;
+    const struct tree_node *root;
+    uint_least64_t state;
+    volatile unsigned long sink;
+};
+
+static void bench_list_traverse(void *ctx, unsigned long n) {
+    struct pointer_ctx *const c = ctx;
+    const struct list_node *p = c->cursor;
+    unsigned long total = 0;
+    unsigned long i;
+
+    for (i = 0; i < n; i ++) {
+        total += (unsigned long)p->value;
+        p = p->next;
+    }
+    c->cursor = p;
+    c->sink = total;
+}
+
+static void bench_tree_lookup(void *ctx, unsigned long n) {
+    struct pointer_ctx *const c = ctx;
+    unsigned long found = 0;
+    unsigned long i;
+
+    for (i = 0; i < n; i ++) {
+        const long key = (long)(bench_random(&c->state) % POINTER_NODES);
+        const struct tree_node *p = c->root;
+        while (p != NULL && p->key != key) {
+            p = key < p->key ? p->left : p->right;
+        }
+        found += p != NULL;
+    }
+    c->sink = found;
+}
+
+/*
+ * Builds a balanced tree of the keys lo .. hi - 1, where the node for
+ * key k is nodes[order[k]].
+ */
+static struct tree_node *build_tree(struct tree_node *nodes, const unsigned long *order,
+                                    unsigned long lo, unsigned long hi)
+{
+    const unsigned long mid = lo + (hi - lo) / 2;
+    struct tree_node *node;
+
+    if (lo >= hi) {
+        return NULL;
+    }
+    node = &nodes[order[mid]];
+    node->key = (long)mid;
+    node->left = build_tree(nodes, order, lo, mid);
+    node->right = build_tree(nodes, order, mid + 1, hi);
+    return node;
+}
+
+static void show_pointer_chasing(FILE *out) {
+    struct list_node *const list = malloc(POINTER_NODES * sizeof *list);
+    struct tree_node *const tree = malloc(POINTER_NODES * sizeof *tree);
+    unsigned long *const order = malloc(POINTER_NODES * sizeof *order);
+    uint_least64_t state = 50;
+    struct pointer_ctx c;
+    struct measurement m;
+    unsigned long i;
+
+    if (list == NULL || tree == NULL || order == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    /* A random permutation of the node positions */
+    for (i = 0; i < POINTER_NODES; i ++) {
+        order[i] = i;
+    }
+    for (i = POINTER_NODES - 1; i > 0; i --) {
+        const unsigned long j = (unsigned long)(bench_random(&state) % (i + 1));
+        const unsigned long tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (i = 0; i < POINTER_NODES; i ++) {
+        list[order[i]].value = (long)i;
+        list[order[i]].next = &list[order[(i + 1) % POINTER_NODES]];
+    }
+    c.cursor = &list[order[0]];
+    c.root = build_tree(tree, order, 0, POINTER_NODES);
+    c.state = 51;
+
+    fputs("[pointer_chasing]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    nodes = %lu\n", (unsigned long)POINTER_NODES);
+    fprintf(out, "    pointer_size = %d\n", (int)(CHAR_BIT * sizeof (void *)));
+    fprintf(out, "    list.node_size = %d\n", (int)(CHAR_BIT * sizeof *list));
+    fprintf(out, "    list.footprint_bytes = %lu\n", (unsigned long)(POINTER_NODES * sizeof *list));
+    measure(bench_list_traverse, &c, &m);
+    show_ns(out, "list.traverse", &m);
+    fprintf(out, "    tree.node_size = %d\n", (int)(CHAR_BIT * sizeof *tree));
+    fprintf(out, "    tree.footprint_bytes = %lu\n", (unsigned long)(POINTER_NODES * sizeof *tree));
+    measure(bench_tree_lookup, &c, &m);
+    show_ns(out, "tree.lookup", &m);
+    putc('\n', out);
+    free(list);
+    free(tree);
+    free(order);
+} /* show_pointer_chasing */
+
+/*
+ * Clock sources.  Every source is read into a struct clock_reading;
+ * readings of the same source are compared with clock_reading_diff_ns(),
+ * which avoids converting absolute times to double.
+ */
+
+enum clock_kind { ck_time, ck_clock, ck_timespec_get, ck_clock_gettime };
+
+struct clock_source {
+    const char *name;
+    enum clock_kind kind;
+#ifdef CLOCK_GETTIME_EXISTS
+    clockid_t id;
+#endif
+};
+
+struct clock_reading {
+    time_t t;
+    clock_t c;
+#if defined(TIME_UTC) || defined(CLOCK_GETTIME_EXISTS)
+    struct timespec ts;
+#endif
+};
+
+#ifdef CLOCK_GETTIME_EXISTS
+#define CLOCK_GETTIME_SOURCE(id) { #id, ck_clock_gettime, id }
+#define OTHER_CLOCK_SOURCE(name, kind) { name, kind, 0 }
+#else
+#define OTHER_CLOCK_SOURCE(name, kind) { name, kind }
+#endif
+
+static const struct clock_source clock_sources[] = {
+    OTHER_CLOCK_SOURCE("time", ck_time),
+    OTHER_CLOCK_SOURCE("clock", ck_clock),
+#ifdef TIME_UTC
+    OTHER_CLOCK_SOURCE("timespec_get", ck_timespec_get),
+#endif
+#ifdef CLOCK_GETTIME_EXISTS
+    CLOCK_GETTIME_SOURCE(CLOCK_REALTIME),
+#ifdef CLOCK_REALTIME_COARSE
+    CLOCK_GETTIME_SOURCE(CLOCK_REALTIME_COARSE),
+#endif
+#ifdef CLOCK_MONOTONIC
+    CLOCK_GETTIME_SOURCE(CLOCK_MONOTONIC),
+#endif
+#ifdef CLOCK_MONOTONIC_COARSE
+    CLOCK_GETTIME_SOURCE(CLOCK_MONOTONIC_COARSE),
+#endif
+#ifdef CLOCK_MONOTONIC_RAW
+    CLOCK_GETTIME_SOURCE(CLOCK_MONOTONIC_RAW),
+#endif
+#ifdef CLOCK_MONOTONIC_RAW_APPROX
+    CLOCK_GETTIME_SOURCE(CLOCK_MONOTONIC_RAW_APPROX),
+#endif
+#ifdef CLOCK_UPTIME_RAW
+    CLOCK_GETTIME_SOURCE(CLOCK_UPTIME_RAW),
+#endif
+#ifdef CLOCK_BOOTTIME
+    CLOCK_GETTIME_SOURCE(CLOCK_BOOTTIME),
+#endif
+#ifdef CLOCK_TAI
+    CLOCK_GETTIME_SOURCE(CLOCK_TAI),
+#endif
+#ifdef CLOCK_PROCESS_CPUTIME_ID
+    CLOCK_GETTIME_SOURCE(CLOCK_PROCESS_CPUTIME_ID),
+#endif
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    CLOCK_GETTIME_SOURCE(CLOCK_THREAD_CPUTIME_ID),
+#endif
+#endif /* CLOCK_GETTIME_EXISTS */
+};
+
+/*
+ * Returns false if the source can't be read on this system.
+ */
+static bool read_clock_source(const struct clock_source *src, struct clock_reading *r) {
+    switch (src->kind) {
+        case ck_time:
+            r->t = time(NULL);
+            return r->t != (time_t)-1;
+        case ck_clock:
+            r->c = clock();
+            return r->c != (clock_t)-1;
+#ifdef TIME_UTC
+        case ck_timespec_get:
+            return timespec_get(&r->ts, TIME_UTC) == TIME_UTC;
+#endif
+#ifdef CLOCK_GETTIME_EXISTS
+        case ck_clock_gettime:
+            return clock_gettime(src->id, &r->ts) == 0;
+#endif
+        default:
+            return false;
+    }
+} /* read_clock_source */
+
+static double clock_reading_diff_ns(const struct clock_source *src,
+                                    const struct clock_reading *later,
+                                    const struct clock_reading *earlier)
+{
+    switch (src->kind) {
+        case ck_time:
+            return difftime(later->t, earlier->t) * 1.0e9;
+        case ck_clock:
+            return (double)(later->c - earlier->c) * 1.0e9 / CLOCKS_PER_SEC;
+#if defined(TIME_UTC) || defined(CLOCK_GETTIME_EXISTS)
+        case ck_timespec_get:
+        case ck_clock_gettime:
+            return (double)(later->ts.tv_sec - earlier->ts.tv_sec) * 1.0e9
+                   + (double)(later->ts.tv_nsec - earlier->ts.tv_nsec);
+#endif
+        default:
+            return 0.0;
+    }
+} /* clock_reading_diff_ns */
+
+/*
+ * Reads the source repeatedly, recording the smallest nonzero step
+ * (the effective resolution, which can't be finer than the cost of
+ * a call) and whether it ever went backwards.  Slow clocks like time()
+ * are sampled until they tick at least once, for up to 2.5 seconds.
+ */
+static void sample_clock_source(const struct clock_source *src,
+                                double *resolution_ns, bool *monotonic)
+{
+    const double start = bench_now();
+    struct clock_reading prev, cur;
+    long ticks = 0;
+    long reads = 0;
+
+    *resolution_ns = -1.0;
+    *monotonic = true;
+    read_clock_source(src, &prev);
+    for (;;) {
+        double diff;
+        read_clock_source(src, &cur);
+        diff = clock_reading_diff_ns(src, &cur, &prev);
+        if (diff < 0.0) {
+            *monotonic = false;
+        }
+        else if (diff > 0.0) {
+            ticks ++;
+            if (*resolution_ns < 0.0 || diff < *resolution_ns) {
+                *resolution_ns = diff;
+            }
+        }
+        prev = cur;
+        if (++reads % 1024 == 0) {
+            const double elapsed = bench_now() - start;
+            if (ticks >= 1000 ||
+                (ticks >= 1 && elapsed >= 0.05) ||
+                elapsed >= 2.5)
+            {
+                break;
+            }
+        }
+    }
+} /* sample_clock_source */
+
+struct clock_call_ctx {
+    const struct clock_source *src;
+    struct clock_reading reading;
+    volatile double sink;
+};
+
+static void bench_clock_call(void *ctx, unsigned long n) {
+    struct clock_call_ctx *const c = ctx;
+    unsigned long i;
+    for (i = 0; i < n; i ++) {
+        read_clock_source(c->src, &c->reading);
+    }
+    c->sink = clock_reading_diff_ns(c->src, &c->reading, &c->reading);
+}
+
+/*
+ * The harness parameters and cycle counter, which apply to every
+ * measurement section.  main() selects this section whenever any
+ * measurement is selected.
+ */
+static void show_benchmark(FILE *out) {
+    fputs("[benchmark]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    bench.trials = %d\n", BENCH_TRIALS);
+    if (BENCH_ITERATIONS > 0) {
+        fprintf(out, "    bench.iterations = %lu\n", (unsigned long)BENCH_ITERATIONS);
+    }
+    else {
+        fprintf(out, "    bench.min_seconds = %g\n", BENCH_MIN_SECONDS);
+    }
+    if (pinned_cpu >= 0) {
+        fprintf(out, "    bench.cpu = %d\n", pinned_cpu);
+    }
+    else {
+        fputs("    bench.cpu = unpinned\n", out);
+    }
+#ifdef CYCLE_COUNTER_EXISTS
+    {
+        /* Calibrate the counter against the clock over about 10 ms */
+        const double start = bench_now();
+        const uint_least64_t start_cycles = bench_cycles();
+        double elapsed;
+        do {
+            elapsed = bench_now() - start;
+        } while (elapsed < 0.01);
+        fprintf(out, "    cycle_counter = %s\n", CYCLE_COUNTER_NAME);
+        fprintf(out, "    cycle_counter.ticks_per_ns = %.3f\n",
+                (double)(bench_cycles() - start_cycles) / (elapsed * 1.0e9));
+    }
+#else
+    fputs("    cycle_counter = unavailable\n", out);
+#endif
+    if (use_counters) {
+        fprintf(out, "    hardware_counters = %d of %d\n", available_hw_counters(), (int)HW_COUNTER_COUNT);
+    }
+    putc('\n', out);
+} /* show_benchmark */
+
+static void show_clocks(FILE *out) {
+    char image[IMAGE_SIZE];
+    size_t i;
+
+    fputs("[clocks]\n", out);
+    fputs("    kind = measurement\n", out);
+    fprintf(out, "    CLOCKS_PER_SEC = %s\n", signed_image(image, (longest_signed)CLOCKS_PER_SEC));
+    for (i = 0; i < sizeof clock_sources / sizeof clock_sources[0]; i ++) {
+        const struct clock_source *const src = &clock_sources[i];
+        struct clock_reading r;
+        struct clock_call_ctx ctx;
+        struct measurement m;
+        double resolution_ns;
+        bool monotonic;
+        char key[KEY_SIZE];
+
+        if (! read_clock_source(src, &r)) {
+            fprintf(out, "    %s.available = false\n", src->name);
+            continue;
+        }
+        fprintf(out, "    %s.available = true\n", src->name);
+#ifdef CLOCK_GETTIME_EXISTS
+        if (src->kind == ck_clock_gettime) {
+            struct timespec res;
+            if (clock_getres(src->id, &res) == 0) {
+                fprintf(out, "    %s.getres_ns = %.0f\n", src->name,
+                       (double)res.tv_sec * 1.0e9 + (double)res.tv_nsec);
+            }
+        }
+#endif
+        sample_clock_source(src, &resolution_ns, &monotonic);
+        if (resolution_ns > 0.0) {
+            fprintf(out, "    %s.resolution_ns = %.0f\n", src->name, resolution_ns);
+        }
+        else {
+            fprintf(out, "    %s.resolution_ns = undetermined\n", src->name);
+        }
+        fprintf(out, "    %s.monotonic = %s\n", src->name, monotonic ? "true" : "false");
+
+        ctx.src = src;
+        measure(bench_clock_call, &ctx, &m);
+        snprintf(key, sizeof key, "%s.call", src->name);
+        show_ns(out, key, &m);
+    }
+    putc('\n', out);
+} /* show_clocks */
+
+#endif /* ENABLE_BENCHMARKS */
+
+/*
+ * Each type section is shown by its own function so that it can be
+ * listed in the probe registry below.
+ */
+
+#ifdef STDBOOL_H_EXISTS
+static void show_bool(FILE *out) {
+    SHOW_INTEGER_TYPE(out, bool, bool_endianness(), 0, 0, false);
+}
+#endif
+
+static void show_small_enum(FILE *out) {
+    SHOW_INTEGER_TYPE(out, enum small_enum, small_enum_endianness(), 0, 0, true);
+}
+
+static void show_small_signed_enum(FILE *out) {
+    SHOW_INTEGER_TYPE(out, enum small_signed_enum, small_signed_enum_endianness(), 0, 0, true);
+}
+
+static void show_char(FILE *out) {
+    SHOW_INTEGER_TYPE(out, char, char_endianness(), CHAR_MIN, CHAR_MAX, false);
+}
+
+#ifdef SIGNED_CHAR_EXISTS
+static void show_signed_char(FILE *out) {
+    SHOW_INTEGER_TYPE(out, signed char, signed_char_endianness(), SCHAR_MIN, SCHAR_MAX, false);
+}
+#endif
+
+static void show_unsigned_char(FILE *out) {
+    SHOW_INTEGER_TYPE(out, unsigned char, unsigned_char_endianness(), 0, UCHAR_MAX, false);
+}
+
+static void show_short(FILE *out) {
+    SHOW_INTEGER_TYPE(out, short, short_endianness(), SHRT_MIN, SHRT_MAX, false);
+}
+
+static void show_unsigned_short(FILE *out) {
+    SHOW_INTEGER_TYPE(out, unsigned short, unsigned_short_endianness(), 0, USHRT_MAX, false);
+}
+
+static void show_int(FILE *out) {
+    SHOW_INTEGER_TYPE(out, int, int_endianness(), INT_MIN, INT_MAX, false);
+}
+
+static void show_unsigned(FILE *out) {
+    SHOW_INTEGER_TYPE(out, unsigned, unsigned_endianness(), 0, UINT_MAX, false);
+}
+
+static void show_long(FILE *out) {
+    SHOW_INTEGER_TYPE(out, long, long_endianness(), LONG_MIN, LONG_MAX, false);
+}
+
+static void show_unsigned_long(FILE *out) {
+    SHOW_INTEGER_TYPE(out, unsigned long, unsigned_long_endianness(), 0, ULONG_MAX, false);
+}
+
+#ifdef LONG_LONG_EXISTS
+static void show_long_long(FILE *out) {
+    SHOW_INTEGER_TYPE(out, long long, long_long_endianness(), MY_LLONG_MIN, MY_LLONG_MAX, false);
+}
+
+static void show_unsigned_long_long(FILE *out) {
+    SHOW_INTEGER_TYPE(out, unsigned long long, unsigned_long_long_endianness(), 0, MY_ULLONG_MAX, false);
+}
+#endif
+
+/*
+ * The extended integer types.  The maximum of an unsigned type is all
+ * ones; that of a signed type is half that (C23 requires two's
+ * complement, and gcc and clang use it for __int128).
+ */
+#define SHOW_EXTENDED_INTEGER_TYPES(name, stype, utype, stype_name, utype_name) \
+static void show_##name(FILE *out) {                                       \
+    const stype max = (stype)((utype)-1 >> 1);                             \
+    char min_image[WIDE_IMAGE_SIZE];                                       \
+    char max_image[WIDE_IMAGE_SIZE];                                       \
+    SHOW_INTEGER_TYPE_WITH_RANGE(out, stype, stype_name, name##_endianness(), \
+                                 name##_signed_image(min_image, -max - 1),  \
+                                 name##_signed_image(max_image, max), false); \
+}                                                                          \
+static void show_u##name(FILE *out) {                                      \
+    char max_image[WIDE_IMAGE_SIZE];                                       \
+    SHOW_INTEGER_TYPE_WITH_RANGE(out, utype, utype_name, u##name##_endianness(), \
+                                 NULL, name##_unsigned_image(max_image, (utype)-1), false); \
+}
+
+#ifdef INT128_EXISTS
+SHOW_EXTENDED_INTEGER_TYPES(int128, int128, uint128, "__int128", "unsigned __int128")
+#endif
+#ifdef BITINT_128_EXISTS
+SHOW_EXTENDED_INTEGER_TYPES(bitint_128, bitint_128, ubitint_128, "_BitInt(128)", "unsigned _BitInt(128)")
+#endif
+#ifdef BITINT_256_EXISTS
+SHOW_EXTENDED_INTEGER_TYPES(bitint_256, bitint_256, ubitint_256, "_BitInt(256)", "unsigned _BitInt(256)")
+#endif
+
+static void show_float(FILE *out) {
+    SHOW_FLOATING_TYPE(out, float,       FLT_MANT_DIG,  FLT_MIN_EXP,  FLT_MAX_EXP,
+                                         f_one, f_minus_sixteen, f_one_million, false);
+}
+
+static void show_double(FILE *out) {
+    SHOW_FLOATING_TYPE(out, double,      DBL_MANT_DIG,  DBL_MIN_EXP,  DBL_MAX_EXP,
+                                         d_one, d_minus_sixteen, d_one_million, false);
+}
+
+#ifdef LONG_DOUBLE_EXISTS
+static void show_long_double(FILE *out) {
+    SHOW_FLOATING_TYPE(out, long double, LDBL_MANT_DIG, LDBL_MIN_EXP, LDBL_MAX_EXP,
+                                         ld_one, ld_minus_sixteen, ld_one_million, false);
+}
+#endif
+
+/*
+ * The extended floating types.  1.0e6 overflows _Float16 (the result
+ * is infinity) and is rounded in __bf16; the bit patterns are still
+ * distinctive.
+ */
+#define DEFINE_SHOW_EXTENDED_FLOATING_TYPE(name, type, type_name, mant_dig, min_exp, max_exp) \
+static void show_##name(FILE *out) {                                       \
+    static const type one = (type)1.0F;                                    \
+    static const type minus_sixteen = (type)-16.0F;                        \
+    static const type one_million = (type)1.0e6;                           \
+    SHOW_FLOATING_TYPE_WITH_NAME(out, type, type_name, mant_dig, min_exp, max_exp, \
+                                 one, minus_sixteen, one_million, false);  \
+}
+
+#ifdef FLOAT16_EXISTS
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_16, float_16, "_Float16",
+    __FLT16_MANT_DIG__, __FLT16_MIN_EXP__, __FLT16_MAX_EXP__)
+#endif
+#ifdef BF16_EXISTS
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(bfloat_16, bfloat_16, "__bf16",
+    __BFLT16_MANT_DIG__, __BFLT16_MIN_EXP__, __BFLT16_MAX_EXP__)
+#endif
+#ifdef FLOATN_EXISTS
+#    ifdef __FLT32_MANT_DIG__
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_32, float_32, "_Float32",
+    __FLT32_MANT_DIG__, __FLT32_MIN_EXP__, __FLT32_MAX_EXP__)
+#    endif
+#    ifdef __FLT64_MANT_DIG__
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_64, float_64, "_Float64",
+    __FLT64_MANT_DIG__, __FLT64_MIN_EXP__, __FLT64_MAX_EXP__)
+#    endif
+#    ifdef __FLT128_MANT_DIG__
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_128, float_128, "_Float128",
+    __FLT128_MANT_DIG__, __FLT128_MIN_EXP__, __FLT128_MAX_EXP__)
+#    endif
+#    ifdef __FLT32X_MANT_DIG__
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_32x, float_32x, "_Float32x",
+    __FLT32X_MANT_DIG__, __FLT32X_MIN_EXP__, __FLT32X_MAX_EXP__)
+#    endif
+#    ifdef __FLT64X_MANT_DIG__
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_64x, float_64x, "_Float64x",
+    __FLT64X_MANT_DIG__, __FLT64X_MIN_EXP__, __FLT64X_MAX_EXP__)
+#    endif
+#    ifdef __FLT128X_MANT_DIG__
+DEFINE_SHOW_EXTENDED_FLOATING_TYPE(float_128x, float_128x, "_Float128x",
+    __FLT128X_MANT_DIG__, __FLT128X_MIN_EXP__, __FLT128X_MAX_EXP__)
+#    endif
+#endif
+
+#ifdef COMPLEX_EXISTS
+static void show_float_complex(FILE *out) {
+    SHOW_COMPLEX_TYPE(out, float _Complex, float);
+}
+
+static void show_double_complex(FILE *out) {
+    SHOW_COMPLEX_TYPE(out, double _Complex, double);
+}
+
+#ifdef LONG_DOUBLE_EXISTS
+static void show_long_double_complex(FILE *out) {
+    SHOW_COMPLEX_TYPE(out, long double _Complex, long double);
+}
+#endif
+#endif
+
+static void show_ptrdiff_t(FILE *out) {
+    SHOW_INTEGER_TYPE(out, ptrdiff_t, ptrdiff_t_endianness(), MY_PTRDIFF_MIN, MY_PTRDIFF_MAX, true);
+}
+
+static void show_size_t(FILE *out) {
+    SHOW_INTEGER_TYPE(out, size_t, size_t_endianness(), 0, MY_SIZE_MAX, true);
+}
+
+static void show_wchar_t(FILE *out) {
+    SHOW_INTEGER_TYPE(out, wchar_t, wchar_t_endianness(), MY_WCHAR_MIN, MY_WCHAR_MAX, true);
+}
+
+static void show_time_t(FILE *out) {
+    if ((time_t)1 / 2 == 0) {
+        SHOW_INTEGER_TYPE(out, time_t, time_t_endianness(), 0, 0, true);
+    }
+    else {
+        static const time_t dummy = 0.0;
+        SHOW_FLOATING_TYPE(out, time_t, 0, 0, 0, dummy, dummy, dummy, true);
+    }
+}
+
+static void show_clock_t(FILE *out) {
+    if ((clock_t)1 / 2 == 0) {
+        SHOW_INTEGER_TYPE(out, clock_t, clock_t_endianness(), 0, 0, true);
+    }
+    else {
+        static const clock_t dummy = 0.0;
+        SHOW_FLOATING_TYPE(out, clock_t, 0, 0, 0, dummy, dummy, dummy, true);
+    }
+}
+
+static void show_struct_tm(FILE *out) {
+    SHOW_RAW_TYPE(out, struct tm);
+}
+
+static void show_void_ptr(FILE *out) {
+    SHOW_RAW_TYPE(out, void*);
+}
+
+static void show_char_ptr(FILE *out) {
+    SHOW_RAW_TYPE(out, char*);
+}
+
+static void show_int_ptr(FILE *out) {
+    SHOW_RAW_TYPE(out, int*);
+}
+
+static void show_double_ptr(FILE *out) {
+    SHOW_RAW_TYPE(out, double*);
+}
+
+static void show_struct_ptr(FILE *out) {
+    SHOW_RAW_TYPE(out, struct{int x;}*);
+}
+
+static void show_simple_func_ptr(FILE *out) {
+    SHOW_RAW_TYPE_WITH_NAME(out, simple_func_ptr, "void(*)(void)");
+}
+
+static void show_complex_func_ptr(FILE *out) {
+    SHOW_RAW_TYPE_WITH_NAME(out, complex_func_ptr, "double(*)(int*,char**)");
+}
+
+/*
+ * Comments about missing sizes.  These depend on integer_sizes[] and
+ * float_sizes[], which the type sections fill in; main() runs any type
+ * sections that weren't selected before this one (see
+ * record_all_sizes()).
+ */
+static void show_size_comments(FILE *out) {
+    check_size(out, "integer", integer_sizes, 8);
+    check_size(out, "integer", integer_sizes, 16);
+    check_size(out, "integer", integer_sizes, 32);
+    check_size(out, "integer", integer_sizes, 64);
+
+    if (huge_integer) {
+        fprintf(out, "[comment-%d]\n", comment_index++);
+        fprintf(out, "    comment = \"There is at least one integer type bigger than %d bits\"\n",
+                MAX_SIZE);
+        putc('\n', out);
+    }
+
+    check_size(out, "floating-point", float_sizes, 32);
+    check_size(out, "floating-point", float_sizes, 64);
+    check_size(out, "floating-point", float_sizes, 128);
+
+    if (huge_float) {
+        fprintf(out, "[comment-%d]\n", comment_index++);
+        fprintf(out, "    comment = \"There is at least one floating-point type bigger than %d bits\"\n",
+                MAX_SIZE);
+        putc('\n', out);
+    }
+}
+
+/*
+ * The probe registry.  Each probe prints one section (or, for
+ * "comments", a group of sections), in this order.  The name is the
+ * section name without any "<" and ">".
+ *
+ * pk_description probes describe the implementation; they're cheap
+ * and always run on the main thread, in order.  pk_measurement probes
+ * may run in parallel with each other (see --jobs).  pk_serial_measurement
+ * probes change process-wide state (such as the locale), so they run
+ * on the main thread after the parallel ones.  Output is always
+ * printed in registry order.
+ */
+
+enum probe_kind { pk_description, pk_measurement, pk_serial_measurement };
+
+struct probe {
+    const char *name;
+    void (*show)(FILE *out);
+    enum probe_kind kind;
+};
+
+static const struct probe probes[] = {
+    { "configuration",          show_configuration,      pk_description },
+    { "predefined_macros",      show_predefined_macros,  pk_description },
+    { "limits.h",               show_limits_h,           pk_description },
+    { "float.h",                show_float_h,            pk_description },
+    { "stdint.h",               show_stdint_h,           pk_description },
+#ifdef STDBOOL_H_EXISTS
+    { "bool",                   show_bool,               pk_description },
+#endif
+    { "enum-small_enum",        show_small_enum,         pk_description },
+    { "enum-small_signed_enum", show_small_signed_enum,  pk_description },
+    { "char",                   show_char,               pk_description },
+#ifdef SIGNED_CHAR_EXISTS
+    { "signed-char",            show_signed_char,        pk_description },
+#endif
+    { "unsigned-char",          show_unsigned_char,      pk_description },
+    { "short",                  show_short,              pk_description },
+    { "unsigned-short",         show_unsigned_short,     pk_description },
+    { "int",                    show_int,                pk_description },
+    { "unsigned",               show_unsigned,           pk_description },
+    { "long",                   show_long,               pk_description },
+    { "unsigned-long",          show_unsigned_long,      pk_description },
+#ifdef LONG_LONG_EXISTS
+    { "long-long",              show_long_long,          pk_description },
+    { "unsigned-long-long",     show_unsigned_long_long, pk_description },
+#endif
+#ifdef INT128_EXISTS
+    { "__int128",               show_int128,             pk_description },
+    { "unsigned-__int128",      show_uint128,            pk_description },
+#endif
+#ifdef BITINT_128_EXISTS
+    { "_BitInt(128)",           show_bitint_128,         pk_description },
+    { "unsigned-_BitInt(128)",  show_ubitint_128,        pk_description },
+#endif
+#ifdef BITINT_256_EXISTS
+    { "_BitInt(256)",           show_bitint_256,         pk_description },
+    { "unsigned-_BitInt(256)",  show_ubitint_256,        pk_description },
+#endif
+    { "float",                  show_float,              pk_description },
+    { "double",                 show_double,             pk_description },
+#ifdef LONG_DOUBLE_EXISTS
+    { "long-double",            show_long_double,        pk_description },
+#endif
+#ifdef FLOAT16_EXISTS
+    { "_Float16",               show_float_16,           pk_description },
+#endif
+#ifdef BF16_EXISTS
+    { "__bf16",                 show_bfloat_16,          pk_description },
+#endif
+#ifdef FLOATN_EXISTS
+#    ifdef __FLT32_MANT_DIG__
+    { "_Float32",               show_float_32,           pk_description },
+#    endif
+#    ifdef __FLT64_MANT_DIG__
+    { "_Float64",               show_float_64,           pk_description },
+#    endif
+#    ifdef __FLT128_MANT_DIG__
+    { "_Float128",              show_float_128,          pk_description },
+#    endif
+#    ifdef __FLT32X_MANT_DIG__
+    { "_Float32x",              show_float_32x,          pk_description },
+#    endif
+#    ifdef __FLT64X_MANT_DIG__
+    { "_Float64x",              show_float_64x,          pk_description },
+#    endif
+#    ifdef __FLT128X_MANT_DIG__
+    { "_Float128x",             show_float_128x,         pk_description },
+#    endif
+#endif
+#ifdef COMPLEX_EXISTS
+    { "float-_Complex",         show_float_complex,      pk_description },
+    { "double-_Complex",        show_double_complex,     pk_description },
+#ifdef LONG_DOUBLE_EXISTS
+    { "long-double-_Complex",   show_long_double_complex, pk_description },
+#endif
+#endif
+    { "ptrdiff_t",              show_ptrdiff_t,          pk_description },
+    { "size_t",                 show_size_t,             pk_description },
+    { "wchar_t",                show_wchar_t,            pk_description },
+    { "time_t",                 show_time_t,             pk_description },
+    { "clock_t",                show_clock_t,            pk_description },
+    { "struct-tm",              show_struct_tm,          pk_description },
+    { "void*",                  show_void_ptr,           pk_description },
+    { "char*",                  show_char_ptr,           pk_description },
+    { "int*",                   show_int_ptr,            pk_description },
+    { "double*",                show_double_ptr,         pk_description },
+    { "struct{int-x;}*",        show_struct_ptr,         pk_description },
+    { "simple_func_ptr",        show_simple_func_ptr,    pk_description },
+    { "complex_func_ptr",       show_complex_func_ptr,   pk_description },
+    { "bitfields",              show_bitfields,          pk_description },
+    { "enum_storage",           show_enum_storage,       pk_description },
+    { "comments",               show_size_comments,      pk_description },
+#ifdef ENABLE_BENCHMARKS
+    { "benchmark",              show_benchmark,          pk_measurement },
+    { "clocks",                 show_clocks,             pk_measurement },
+    { "text_conversion",        show_text_conversion,    pk_measurement },
+    { "integer_division",       show_integer_division,   pk_measurement },
+    { "floating_arithmetic",    show_floating_arithmetic, pk_measurement },
+    { "multibyte_conversion",   show_multibyte_conversion, pk_serial_measurement },
+#if UINT_MAX >= 0xffffffff
+    { "bitfield_access",        show_bitfield_access,    pk_measurement },
+#endif
+    { "struct_passing",         show_struct_passing,     pk_measurement },
+#ifdef UINTPTR_MAX
+    { "address_space",          show_address_space,      pk_measurement },
+#endif
+    { "bool_predicates",        show_bool_predicates,    pk_measurement },
+    { "enum_access",            show_enum_access,        pk_measurement },
+    { "scratch_buffers",        show_scratch_buffers,    pk_measurement },
+#ifdef COMPLEX_EXISTS
+    { "complex_arithmetic",     show_complex_arithmetic, pk_measurement },
+#endif
+    { "loop_index",             show_loop_index,         pk_measurement },
+    { "checked_arithmetic",     show_checked_arithmetic, pk_measurement },
+    { "floating_conversion",    show_floating_conversion, pk_measurement },
+    { "sort_search",            show_sort_search,        pk_measurement },
+    { "extended_integers",      show_extended_integers,  pk_measurement },
+    { "half_precision",         show_half_precision,     pk_measurement },
+    { "pointer_chasing",        show_pointer_chasing,    pk_measurement },
+#endif
+};
+
+#define PROBE_COUNT (sizeof probes / sizeof probes[0])
+
+#ifdef PARALLEL_PROBES_SUPPORTED
+
+/*
+ * Worker threads take the next pending measurement probe from the
+ * queue until there are none left.
+ */
+struct probe_queue {
+    const struct probe *const *selected;
+    FILE **outputs;
+    size_t count;
+    size_t next;
+    probe_mutex lock;
+};
+
+static void run_probe_queue(struct probe_queue *q) {
+    for (;;) {
+        size_t i;
+        probe_mutex_lock(&q->lock);
+        while (q->next < q->count && q->selected[q->next]->kind != pk_measurement) {
+            q->next ++;
+        }
+        i = q->next++;
+        probe_mutex_unlock(&q->lock);
+        if (i >= q->count) {
+            break;
+        }
+        q->selected[i]->show(q->outputs[i]);
+    }
+}
+
+PROBE_THREAD_FUNCTION(probe_worker, arg) {
+    run_probe_queue(arg);
+    PROBE_THREAD_RETURN;
+}
+
+/*
+ * Runs the selected probes with up to jobs measurement probes at
+ * a time, each writing to its own temporary file, then copies the
+ * output to stdout in order.  Returns false if the temporary files
+ * can't be created.
+ */
+static bool run_probes_in_parallel(const struct probe *const *selected, size_t count, int jobs) {
+    FILE **const outputs = malloc(count * sizeof *outputs);
+    probe_thread *const threads = malloc((size_t)jobs * sizeof *threads);
+    struct probe_queue q;
+    int started = 0;
+    size_t i;
+
+    if (outputs == NULL || threads == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < count; i ++) {
+        outputs[i] = tmpfile();
+        if (outputs[i] == NULL) {
+            while (i-- > 0) {
+                fclose(outputs[i]);
+            }
+            free(outputs);
+            free(threads);
+            return false;
+        }
+    }
+
+    for (i = 0; i < count; i ++) {
+        if (selected[i]->kind == pk_description) {
+            selected[i]->show(outputs[i]);
+        }
+    }
+
+    q.selected = selected;
+    q.outputs = outputs;
+    q.count = count;
+    q.next = 0;
+    probe_mutex_init(&q.lock);
+    while (started < jobs && probe_thread_create(&threads[started], probe_worker, &q)) {
+        started ++;
+    }
+    if (started == 0) {
+        run_probe_queue(&q);
+    }
+    while (started > 0) {
+        probe_thread_join(threads[--started]);
+    }
+    probe_mutex_destroy(&q.lock);
+
+    for (i = 0; i < count; i ++) {
+        if (selected[i]->kind == pk_serial_measurement) {
+            selected[i]->show(outputs[i]);
+        }
+    }
+
+    for (i = 0; i < count; i ++) {
+        char buffer[4096];
+        size_t n;
+        rewind(outputs[i]);
+        while ((n = fread(buffer, 1, sizeof buffer, outputs[i])) > 0) {
+            fwrite(buffer, 1, n, stdout);
+        }
+        fclose(outputs[i]);
+    }
+    free(outputs);
+    free(threads);
+    return true;
+} /* run_probes_in_parallel */
+
+#endif /* PARALLEL_PROBES_SUPPORTED */
+
+static void run_probes(const struct probe *const *selected, size_t count, int jobs) {
+    size_t i;
+#ifdef PARALLEL_PROBES_SUPPORTED
+    if (jobs > 1 && run_probes_in_parallel(selected, count, jobs)) {
+        return;
+    }
+#else
+    (void)jobs;
+#endif
+    for (i = 0; i < count; i ++) {
+        selected[i]->show(stdout);
+    }
+}
+
+/*
+ * Runs the description probes that weren't selected, discarding their
+ * output, so that integer_sizes[] and float_sizes[] are complete for
+ * the "comments" section whatever --sections selected.
+ */
+static void record_all_sizes(const bool wanted[]) {
+    FILE *const scratch = tmpfile();
+    size_t i;
+    if (scratch == NULL) {
+        perror("tmpfile");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < PROBE_COUNT; i ++) {
+        if (! wanted[i] && probes[i].kind == pk_description &&
+            probes[i].show != show_size_comments)
+        {
+            probes[i].show(scratch);
+        }
+    }
+    fclose(scratch);
+}
+
+static const struct probe *find_probe(const char *name, size_t len) {
+    size_t i;
+    if (len >= 2 && name[0] == '<' && name[len - 1] == '>') {
+        name ++;
+        len -= 2;
+    }
+    for (i = 0; i < PROBE_COUNT; i ++) {
+        if (strlen(probes[i].name) == len && strncmp(probes[i].name, name, len) == 0) {
+            return &probes[i];
+        }
+    }
+    return NULL;
+}
+
+static void usage(const char *program_name) {
+#ifdef ENABLE_BENCHMARKS
+    fprintf(stderr, "Usage: %s [--sections=name,...] [--jobs=n] [--list-sections]\n"
+                    "       [--statistics] [--counters] [--cpu=n] [key=value...]\n",
+            program_name);
+#else
+    fprintf(stderr, "Usage: %s [--sections=name,...] [--jobs=n] [--list-sections] [key=value...]\n",
+            program_name);
+#endif
+    exit(EXIT_FAILURE);
+}
+
+#ifdef ENABLE_BENCHMARKS
+/*
+ * Pins the process to one CPU, so that measurements aren't disturbed
+ * by migrations.  Returns false if that isn't possible.
+ */
+static bool pin_to_cpu(int cpu) {
+#ifdef SCHED_SETAFFINITY_EXISTS
+    cpu_set_t set;
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof set, &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+#endif
+
+int main(int argc, char **argv) {
+    static bool wanted[PROBE_COUNT];
+    const struct probe *selected[PROBE_COUNT];
+    const char *sections = NULL;
+    size_t count = 0;
+    int jobs = 1;
+    size_t i;
+    int a;
+
+    program_argc = argc;
+    program_argv = argv;
+    for (a = 1; a < argc; a ++) {
+        if (! is_option(argv[a])) {
+            continue;
+        }
+        else if (strncmp(argv[a], "--sections=", 11) == 0) {
+            sections = argv[a] + 11;
+        }
+        else if (strncmp(argv[a], "--jobs=", 7) == 0) {
+            jobs = atoi(argv[a] + 7);
+            if (jobs < 1) {
+                usage(argv[0]);
+            }
+        }
+#ifdef ENABLE_BENCHMARKS
+        else if (strcmp(argv[a], "--statistics") == 0) {
+            show_statistics = true;
+        }
+        else if (strcmp(argv[a], "--counters") == 0) {
+            use_counters = true;
+        }
+        else if (strncmp(argv[a], "--cpu=", 6) == 0) {
+            pinned_cpu = atoi(argv[a] + 6);
+            if (pinned_cpu < 0) {
+                usage(argv[0]);
+            }
+        }
+#endif
+        else if (strcmp(argv[a], "--list-sections") == 0) {
+            for (i = 0; i < PROBE_COUNT; i ++) {
+                puts(probes[i].name);
+            }
+            exit(EXIT_SUCCESS);
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+
+    /*
+     * The configuration section is always shown.  Without --sections,
+     * everything is.  "descriptions" selects all the sections that
+     * aren't measurements.
+     */
+    for (i = 0; i < PROBE_COUNT; i ++) {
+        wanted[i] = sections == NULL || probes[i].show == show_configuration;
+    }
+    while (sections != NULL && *sections != '\0') {
+        const char *const comma = strchr(sections, ',');
+        const size_t len = comma == NULL ? strlen(sections) : (size_t)(comma - sections);
+        const struct probe *const p = find_probe(sections, len);
+        if (p == NULL && len == 12 && strncmp(sections, "descriptions", len) == 0) {
+            for (i = 0; i < PROBE_COUNT; i ++) {
+                if (probes[i].kind == pk_description) {
+                    wanted[i] = true;
+                }
+            }
+            sections = comma == NULL ? NULL : comma + 1;
+            continue;
+        }
+        if (p == NULL) {
+            fprintf(stderr, "%s: unknown section \"%.*s\" (see --list-sections)\n",
+                    argv[0], (int)len, sections);
+            exit(EXIT_FAILURE);
+        }
+        wanted[p - probes] = true;
+        sections = comma == NULL ? NULL : comma + 1;
+    }
+#ifdef ENABLE_BENCHMARKS
+    /*
+     * The harness parameters go with any measurement.
+     */
+    for (i = 0; i < PROBE_COUNT; i ++) {
+        if (wanted[i] && probes[i].kind != pk_description) {
+            wanted[find_probe("benchmark", 9) - probes] = true;
+            break;
+        }
+    }
+#endif
+    for (i = 0; i < PROBE_COUNT; i ++) {
+        if (wanted[i]) {
+            selected[count++] = &probes[i];
+        }
+    }
+    for (i = 0; i < PROBE_COUNT; i ++) {
+        if (wanted[i] && probes[i].show == show_size_comments) {
+            record_all_sizes(wanted);
+        }
+    }
+
+#ifdef ENABLE_BENCHMARKS
+    /*
+     * Measurements running in parallel on one CPU would only disturb
+     * each other.
+     */
+    if (pinned_cpu >= 0 && jobs > 1) {
+        fprintf(stderr, "%s: --cpu can't be combined with --jobs\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if (pinned_cpu >= 0 && ! pin_to_cpu(pinned_cpu)) {
+        fprintf(stderr, "%s: can't pin to CPU %d\n", argv[0], pinned_cpu);
+        exit(EXIT_FAILURE);
     }
+#endif
+
+    set_formats();
+    run_probes(selected, count, jobs);
 
     exit(EXIT_SUCCESS);
 } /* main */
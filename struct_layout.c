@@ -0,0 +1,928 @@
+/*
+ * Copyright (C) 2026 Keith Thompson
+ */
+
+/*
+ * This file is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * struct_layout reads struct and union definitions and shows their
+ * layout (member offsets, size, alignment and padding) on every target
+ * in a results directory, using the sizes and alignments recorded by
+ * show_c_types, so no cross compiler is needed.
+ *
+ * Usage:
+ *     struct_layout [-d directory] [-D] [file...]
+ *
+ * The definitions are read from the named files, or from stdin.  The
+ * directory defaults to "results".  With -D, only rows that differ
+ * between targets are shown.
+ *
+ * The input is a subset of C: struct and union definitions (possibly
+ * in a typedef) whose members have the predefined arithmetic types,
+ * size_t, ptrdiff_t, wchar_t, time_t, clock_t, the exact-width types
+ * from <stdint.h>, intptr_t and uintptr_t, enum types (assumed to have
+ * the layout of show_c_types's small_enum), object and function
+ * pointers (including pointers to structs and unions that aren't
+ * defined yet, such as the struct itself), and structs and unions
+ * defined earlier in the input, possibly as arrays with constant
+ * bounds.  Comments and preprocessor lines are ignored, as is anything
+ * else at file scope.  Bit-fields are not supported, since their
+ * layout isn't recorded in older results.
+ *
+ * Each struct is shown as a table with one column per target; the
+ * legend at the top gives the target for each column number.  Offsets
+ * and sizes are in bytes, since that's how struct layouts are usually
+ * discussed (show_c_types itself reports sizes in bits).  A "?" means
+ * the target's results don't describe a type that's needed; a "*" at
+ * the end of a row means the values differ between targets.
+ *
+ * The sections used are found by name, with spaces and hyphens
+ * treated as equivalent (older results have "[long double]", newer
+ * ones "[long-double]").  Integer types record their alignment as
+ * "align", other types as "alignment".
+ *
+ * Author: Keith Thompson <Keith.S.Thompson@gmail.com>
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+#include <dirent.h>
+
+#define DEFAULT_DIRECTORY "results"
+#define NAME_SIZE 64
+#define UNKNOWN (-1L)
+
+/*
+ * Sizes and alignments, in bits, for one target.
+ */
+struct type_info {
+    char name[NAME_SIZE];
+    long size;
+    long align;
+};
+
+struct target {
+    char *name;
+    struct type_info *types;
+    size_t type_count;
+};
+
+enum member_kind { mk_type, mk_aggregate, mk_pointer, mk_function_pointer };
+
+struct member {
+    char name[NAME_SIZE];
+    enum member_kind kind;
+    char type[NAME_SIZE];                   /* for mk_type */
+    const struct aggregate *aggregate;      /* for mk_aggregate */
+    unsigned long count;                    /* array elements, or 1 */
+};
+
+struct aggregate {
+    char name[NAME_SIZE];
+    char typedef_name[NAME_SIZE];
+    int is_union;
+    struct member *members;
+    size_t member_count;
+};
+
+/*
+ * The layout of an aggregate on one target, in bytes.  Values are
+ * UNKNOWN if a type isn't described by the target's results.
+ */
+struct layout {
+    long size;
+    long align;
+    long padding;
+    long *offsets;
+};
+
+static struct target *targets = NULL;
+static size_t target_count = 0;
+static struct aggregate **aggregates = NULL;
+static size_t aggregate_count = 0;
+
+static void *xrealloc(void *ptr, size_t size) {
+    void *const result = realloc(ptr, size);
+    if (result == NULL && size != 0) {
+        fprintf(stderr, "realloc failed\n");
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+/*
+ * Copies s to result (which has room for NAME_SIZE characters),
+ * replacing each space by a hyphen.
+ */
+static void normalize_name(char *result, const char *s) {
+    size_t i;
+    for (i = 0; s[i] != '\0' && i < NAME_SIZE - 1; i ++) {
+        result[i] = s[i] == ' ' ? '-' : s[i];
+    }
+    result[i] = '\0';
+}
+
+/*
+ * Reads the whole file into a malloc()ed, null-terminated buffer.
+ * Returns NULL on failure.
+ */
+static char *read_file(FILE *f) {
+    char *buffer = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    size_t n;
+
+    do {
+        if (capacity - size < 4096) {
+            capacity = capacity == 0 ? 65536 : 2 * capacity;
+            buffer = xrealloc(buffer, capacity);
+        }
+        n = fread(buffer + size, 1, capacity - size - 1, f);
+        size += n;
+    } while (n > 0);
+    if (ferror(f)) {
+        free(buffer);
+        return NULL;
+    }
+    buffer[size] = '\0';
+    return buffer;
+}
+
+/*
+ * Loading results.
+ */
+
+static struct type_info *find_type_info(const struct target *t, const char *name) {
+    char normalized[NAME_SIZE];
+    size_t i;
+    normalize_name(normalized, name);
+    for (i = 0; i < t->type_count; i ++) {
+        if (strcmp(t->types[i].name, normalized) == 0) {
+            return &t->types[i];
+        }
+    }
+    return NULL;
+}
+
+static int load_target(const char *path, const char *name) {
+    FILE *const f = fopen(path, "r");
+    struct target t;
+    struct type_info *current = NULL;
+    char line[1024];
+
+    if (f == NULL) {
+        perror(path);
+        return 0;
+    }
+    t.name = xrealloc(NULL, strlen(name) + 1);
+    strcpy(t.name, name);
+    t.types = NULL;
+    t.type_count = 0;
+
+    while (fgets(line, sizeof line, f) != NULL) {
+        char key[NAME_SIZE];
+        long value;
+        if (line[0] == '[') {
+            char *const end = strchr(line, ']');
+            if (end == NULL) {
+                current = NULL;
+                continue;
+            }
+            *end = '\0';
+            t.types = xrealloc(t.types, (t.type_count + 1) * sizeof *t.types);
+            current = &t.types[t.type_count++];
+            normalize_name(current->name, line + 1);
+            current->size = UNKNOWN;
+            current->align = UNKNOWN;
+        }
+        else if (current != NULL && sscanf(line, " %63s = %ld", key, &value) == 2) {
+            if (strcmp(key, "size") == 0) {
+                current->size = value;
+            }
+            else if (strcmp(key, "align") == 0 || strcmp(key, "alignment") == 0) {
+                current->align = value;
+            }
+        }
+    }
+    fclose(f);
+
+    targets = xrealloc(targets, (target_count + 1) * sizeof *targets);
+    targets[target_count++] = t;
+    return 1;
+} /* load_target */
+
+static int compare_targets(const void *a, const void *b) {
+    return strcmp(((const struct target *)a)->name, ((const struct target *)b)->name);
+}
+
+static int load_results(const char *directory) {
+    DIR *const dir = opendir(directory);
+    struct dirent *e;
+    int ok = 1;
+
+    if (dir == NULL) {
+        perror(directory);
+        return 0;
+    }
+    while ((e = readdir(dir)) != NULL) {
+        const size_t len = strlen(e->d_name);
+        char *path;
+        char *name;
+        if (len <= 4 || strcmp(e->d_name + len - 4, ".ini") != 0) {
+            continue;
+        }
+        path = xrealloc(NULL, strlen(directory) + len + 2);
+        sprintf(path, "%s/%s", directory, e->d_name);
+        name = xrealloc(NULL, len - 3);
+        memcpy(name, e->d_name, len - 4);
+        name[len - 4] = '\0';
+        if (! load_target(path, name)) {
+            ok = 0;
+        }
+        free(path);
+        free(name);
+    }
+    closedir(dir);
+    if (target_count == 0) {
+        fprintf(stderr, "No *.ini files in %s\n", directory);
+        return 0;
+    }
+    qsort(targets, target_count, sizeof *targets, compare_targets);
+    return ok;
+} /* load_results */
+
+/*
+ * Finds the size and alignment, in bits, of a type named as in the
+ * input (after normalize_type_name()) on one target.  Returns 0 if
+ * the target's results don't describe it.
+ */
+static int lookup_type(const struct target *t, const char *name, long *size, long *align) {
+    const struct type_info *info;
+    int bits;
+
+    if (sscanf(name, "int%d_t", &bits) == 1 || sscanf(name, "uint%d_t", &bits) == 1) {
+        /* An exact-width type is one of the predefined integer types */
+        static const char *const candidates[] = {
+            "signed char", "short", "int", "long", "long long"
+        };
+        size_t i;
+        for (i = 0; i < sizeof candidates / sizeof candidates[0]; i ++) {
+            info = find_type_info(t, candidates[i]);
+            if (info != NULL && info->size == bits && info->align != UNKNOWN) {
+                *size = info->size;
+                *align = info->align;
+                return 1;
+            }
+        }
+        return 0;
+    }
+    if (strcmp(name, "intptr_t") == 0 || strcmp(name, "uintptr_t") == 0) {
+        char exact[NAME_SIZE];
+        long pointer_align;
+        if (! lookup_type(t, "void*", size, &pointer_align)) {
+            return 0;
+        }
+        sprintf(exact, "int%ld_t", *size);
+        return lookup_type(t, exact, size, align);
+    }
+    if (strncmp(name, "enum ", 5) == 0) {
+        name = "enum small_enum";
+    }
+    info = find_type_info(t, name);
+    if (info == NULL || info->size == UNKNOWN || info->align == UNKNOWN) {
+        return 0;
+    }
+    *size = info->size;
+    *align = info->align;
+    return 1;
+} /* lookup_type */
+
+/*
+ * Reading definitions.  The input is split into tokens: identifiers
+ * and numbers, and single punctuation characters.
+ */
+
+struct token {
+    char text[NAME_SIZE];
+    int line;
+};
+
+struct input {
+    const char *file_name;
+    struct token *tokens;
+    size_t count;
+    size_t pos;
+};
+
+static void parse_error_at(const char *file_name, int line, const char *message) {
+    fprintf(stderr, "%s:%d: %s\n", file_name, line, message);
+    exit(EXIT_FAILURE);
+}
+
+static void tokenize(struct input *in, const char *p) {
+    int line = 1;
+    int at_line_start = 1;
+
+    in->tokens = NULL;
+    in->count = 0;
+    in->pos = 0;
+    while (*p != '\0') {
+        struct token *t;
+        size_t len = 0;
+
+        if (*p == '\n') {
+            line ++;
+            at_line_start = 1;
+            p ++;
+            continue;
+        }
+        if (isspace((unsigned char)*p)) {
+            p ++;
+            continue;
+        }
+        if (p[0] == '/' && p[1] == '*') {
+            for (p += 2; *p != '\0' && ! (p[0] == '*' && p[1] == '/'); p ++) {
+                line += *p == '\n';
+            }
+            p += *p == '\0' ? 0 : 2;
+            continue;
+        }
+        if ((p[0] == '/' && p[1] == '/') || (*p == '#' && at_line_start)) {
+            /* A comment or preprocessor line, possibly continued */
+            for (; *p != '\0' && *p != '\n'; p ++) {
+                if (p[0] == '\\' && p[1] == '\n') {
+                    p ++;
+                    line ++;
+                }
+            }
+            continue;
+        }
+        at_line_start = 0;
+
+        in->tokens = xrealloc(in->tokens, (in->count + 1) * sizeof *in->tokens);
+        t = &in->tokens[in->count++];
+        t->line = line;
+        if (isalnum((unsigned char)*p) || *p == '_') {
+            while (isalnum((unsigned char)p[len]) || p[len] == '_') {
+                len ++;
+            }
+        }
+        else {
+            len = 1;
+        }
+        if (len >= NAME_SIZE) {
+            parse_error_at(in->file_name, line, "token too long");
+        }
+        memcpy(t->text, p, len);
+        t->text[len] = '\0';
+        p += len;
+    }
+} /* tokenize */
+
+static const char *peek(const struct input *in, size_t ahead) {
+    return in->pos + ahead < in->count ? in->tokens[in->pos + ahead].text : "";
+}
+
+static const char *next(struct input *in) {
+    const char *const result = peek(in, 0);
+    if (in->pos < in->count) {
+        in->pos ++;
+    }
+    return result;
+}
+
+static void parse_error(const struct input *in, const char *message) {
+    const int line = in->pos < in->count ? in->tokens[in->pos].line :
+                     in->count > 0 ? in->tokens[in->count - 1].line : 0;
+    parse_error_at(in->file_name, line, message);
+}
+
+static void expect(struct input *in, const char *text) {
+    if (strcmp(peek(in, 0), text) != 0) {
+        char message[NAME_SIZE + 32];
+        sprintf(message, "expected \"%s\"", text);
+        parse_error(in, message);
+    }
+    next(in);
+}
+
+static int is_identifier(const char *s) {
+    return isalpha((unsigned char)s[0]) || s[0] == '_';
+}
+
+static const struct aggregate *find_aggregate(const char *name, int by_typedef) {
+    size_t i;
+    for (i = aggregate_count; i > 0; i --) {
+        const struct aggregate *const a = aggregates[i - 1];
+        if (strcmp(by_typedef ? a->typedef_name : a->name, name) == 0) {
+            return a;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Returns the section name for a list of arithmetic type keywords, or
+ * NULL if the next token doesn't start one.
+ */
+static const char *parse_arithmetic_type(struct input *in) {
+    int is_signed = 0, is_unsigned = 0, is_char = 0, is_short = 0, is_int = 0;
+    int longs = 0, is_float = 0, is_double = 0, is_bool = 0;
+    int any = 0;
+
+    for (;;) {
+        const char *const t = peek(in, 0);
+        if      (strcmp(t, "signed") == 0)   is_signed = 1;
+        else if (strcmp(t, "unsigned") == 0) is_unsigned = 1;
+        else if (strcmp(t, "char") == 0)     is_char = 1;
+        else if (strcmp(t, "short") == 0)    is_short = 1;
+        else if (strcmp(t, "int") == 0)      is_int = 1;
+        else if (strcmp(t, "long") == 0)     longs ++;
+        else if (strcmp(t, "float") == 0)    is_float = 1;
+        else if (strcmp(t, "double") == 0)   is_double = 1;
+        else if (strcmp(t, "_Bool") == 0 || strcmp(t, "bool") == 0) is_bool = 1;
+        else if (strcmp(t, "const") == 0 || strcmp(t, "volatile") == 0) ;
+        else break;
+        any = 1;
+        next(in);
+    }
+    (void)is_signed;
+    (void)is_int;
+    if (! any) {
+        return NULL;
+    }
+    if (is_bool)   return "bool";
+    if (is_float)  return "float";
+    if (is_double) return longs > 0 ? "long double" : "double";
+    if (is_char)   return is_unsigned ? "unsigned char" : is_signed ? "signed char" : "char";
+    if (is_short)  return is_unsigned ? "unsigned short" : "short";
+    if (longs == 1) return is_unsigned ? "unsigned long" : "long";
+    if (longs >= 2) return is_unsigned ? "unsigned long long" : "long long";
+    return is_unsigned ? "unsigned" : "int";
+} /* parse_arithmetic_type */
+
+static const struct aggregate *parse_aggregate(struct input *in);
+
+/*
+ * Parses one member declaration, which may declare several members,
+ * and adds them to a.
+ */
+static void parse_member(struct input *in, struct aggregate *a) {
+    struct member base;
+    const char *arithmetic;
+
+    memset(&base, 0, sizeof base);
+    while (strcmp(peek(in, 0), "const") == 0 || strcmp(peek(in, 0), "volatile") == 0) {
+        next(in);
+    }
+    if (strcmp(peek(in, 0), "struct") == 0 || strcmp(peek(in, 0), "union") == 0) {
+        if (strcmp(peek(in, 1), "{") == 0 || strcmp(peek(in, 2), "{") == 0) {
+            base.aggregate = parse_aggregate(in);
+        }
+        else {
+            /*
+             * The tag may not be defined yet (or may be the one being
+             * defined, as in a list node); that's only an error if a
+             * member isn't a pointer.  See below.
+             */
+            next(in);
+            base.aggregate = find_aggregate(next(in), 0);
+        }
+        base.kind = mk_aggregate;
+    }
+    else if (strcmp(peek(in, 0), "enum") == 0) {
+        next(in);
+        if (is_identifier(peek(in, 0))) {
+            next(in);
+        }
+        if (strcmp(peek(in, 0), "{") == 0) {
+            while (strcmp(peek(in, 0), "}") != 0 && peek(in, 0)[0] != '\0') {
+                next(in);
+            }
+            expect(in, "}");
+        }
+        base.kind = mk_type;
+        strcpy(base.type, "enum small_enum");
+    }
+    else if ((arithmetic = parse_arithmetic_type(in)) != NULL) {
+        base.kind = mk_type;
+        strcpy(base.type, arithmetic);
+    }
+    else if (is_identifier(peek(in, 0))) {
+        const char *const name = next(in);
+        base.aggregate = find_aggregate(name, 1);
+        if (base.aggregate != NULL) {
+            base.kind = mk_aggregate;
+        }
+        else {
+            base.kind = mk_type;
+            strcpy(base.type, name);
+        }
+    }
+    else {
+        parse_error(in, "expected a type");
+    }
+    while (strcmp(peek(in, 0), "const") == 0 || strcmp(peek(in, 0), "volatile") == 0) {
+        next(in);
+    }
+
+    for (;;) {
+        struct member m = base;
+        m.count = 1;
+        if (strcmp(peek(in, 0), "(") == 0 && strcmp(peek(in, 1), "*") == 0) {
+            /* A function pointer: (*name[n]...)(parameters) */
+            next(in);
+            next(in);
+            m.kind = mk_function_pointer;
+        }
+        else {
+            while (strcmp(peek(in, 0), "*") == 0 || strcmp(peek(in, 0), "const") == 0 ||
+                   strcmp(peek(in, 0), "volatile") == 0)
+            {
+                if (strcmp(next(in), "*") == 0) {
+                    m.kind = mk_pointer;
+                }
+            }
+        }
+        if (m.kind == mk_aggregate && m.aggregate == NULL) {
+            parse_error(in, "struct or union used before its definition");
+        }
+        if (! is_identifier(peek(in, 0))) {
+            parse_error(in, "expected a member name");
+        }
+        strcpy(m.name, next(in));
+        while (strcmp(peek(in, 0), "[") == 0) {
+            char *end;
+            unsigned long n;
+            next(in);
+            n = strtoul(peek(in, 0), &end, 0);
+            while (*end == 'u' || *end == 'U' || *end == 'l' || *end == 'L') {
+                end ++;
+            }
+            if (! isdigit((unsigned char)peek(in, 0)[0]) || *end != '\0' || n == 0) {
+                parse_error(in, "array bounds must be positive integer constants");
+            }
+            next(in);
+            expect(in, "]");
+            m.count *= n;
+        }
+        if (m.kind == mk_function_pointer) {
+            int depth = 1;
+            expect(in, ")");
+            expect(in, "(");
+            while (depth > 0 && peek(in, 0)[0] != '\0') {
+                const char *const t = next(in);
+                depth += strcmp(t, "(") == 0;
+                depth -= strcmp(t, ")") == 0;
+            }
+        }
+        if (strcmp(peek(in, 0), ":") == 0) {
+            parse_error(in, "bit-fields are not supported");
+        }
+
+        a->members = xrealloc(a->members, (a->member_count + 1) * sizeof *a->members);
+        a->members[a->member_count++] = m;
+
+        if (strcmp(peek(in, 0), ",") != 0) {
+            break;
+        }
+        next(in);
+    }
+    expect(in, ";");
+} /* parse_member */
+
+/*
+ * Parses "struct [name] { members }" or the same with "union", adds
+ * it to aggregates[] and returns it.
+ */
+static const struct aggregate *parse_aggregate(struct input *in) {
+    struct aggregate *const a = xrealloc(NULL, sizeof *a);
+
+    memset(a, 0, sizeof *a);
+    a->is_union = strcmp(next(in), "union") == 0;
+    if (is_identifier(peek(in, 0))) {
+        strcpy(a->name, next(in));
+    }
+    expect(in, "{");
+    while (strcmp(peek(in, 0), "}") != 0) {
+        if (peek(in, 0)[0] == '\0') {
+            parse_error(in, "unexpected end of input");
+        }
+        parse_member(in, a);
+    }
+    next(in);
+    if (a->member_count == 0) {
+        parse_error(in, "empty struct or union");
+    }
+    aggregates = xrealloc(aggregates, (aggregate_count + 1) * sizeof *aggregates);
+    aggregates[aggregate_count++] = a;
+    return a;
+} /* parse_aggregate */
+
+/*
+ * Skips a file-scope declaration or function definition that isn't
+ * a struct or union definition.
+ */
+static void skip_declaration(struct input *in) {
+    int depth = 0;
+    while (peek(in, 0)[0] != '\0') {
+        const char *const t = next(in);
+        if (strcmp(t, "{") == 0 || strcmp(t, "(") == 0 || strcmp(t, "[") == 0) {
+            depth ++;
+        }
+        else if (strcmp(t, "}") == 0 || strcmp(t, ")") == 0 || strcmp(t, "]") == 0) {
+            depth --;
+            if (depth == 0 && strcmp(t, "}") == 0 && strcmp(peek(in, 0), ";") != 0) {
+                return;
+            }
+        }
+        else if (depth == 0 && strcmp(t, ";") == 0) {
+            return;
+        }
+    }
+}
+
+static void parse_input(struct input *in) {
+    while (in->pos < in->count) {
+        int is_typedef = 0;
+        if (strcmp(peek(in, 0), "typedef") == 0) {
+            is_typedef = 1;
+            next(in);
+        }
+        if ((strcmp(peek(in, 0), "struct") == 0 || strcmp(peek(in, 0), "union") == 0) &&
+            (strcmp(peek(in, 1), "{") == 0 || strcmp(peek(in, 2), "{") == 0))
+        {
+            struct aggregate *const a = (struct aggregate *)parse_aggregate(in);
+            if (is_typedef && is_identifier(peek(in, 0))) {
+                strcpy(a->typedef_name, next(in));
+            }
+            skip_declaration(in);
+        }
+        else {
+            skip_declaration(in);
+        }
+    }
+}
+
+/*
+ * Computing layouts.
+ */
+
+/*
+ * Finds the size and alignment of a member, in bytes, on target t.
+ * Returns 0 if they're unknown.
+ */
+static int compute_layout(const struct aggregate *a, const struct target *t, struct layout *l);
+
+static int member_size(const struct member *m, const struct target *t, long *size, long *align) {
+    long char_bits, dummy;
+    if (! lookup_type(t, "char", &char_bits, &dummy)) {
+        char_bits = 8;
+    }
+    switch (m->kind) {
+        case mk_aggregate: {
+            struct layout l;
+            int ok;
+            l.offsets = xrealloc(NULL, m->aggregate->member_count * sizeof *l.offsets);
+            ok = compute_layout(m->aggregate, t, &l);
+            free(l.offsets);
+            if (! ok) {
+                return 0;
+            }
+            *size = l.size;
+            *align = l.align;
+            break;
+        }
+        case mk_pointer:
+            if (! lookup_type(t, "void*", size, align)) {
+                return 0;
+            }
+            *size /= char_bits;
+            *align /= char_bits;
+            break;
+        case mk_function_pointer:
+            if (! lookup_type(t, "void(*)(void)", size, align) &&
+                ! lookup_type(t, "simple_func_ptr", size, align))
+            {
+                return 0;
+            }
+            *size /= char_bits;
+            *align /= char_bits;
+            break;
+        default:
+            if (! lookup_type(t, m->type, size, align)) {
+                return 0;
+            }
+            *size /= char_bits;
+            *align /= char_bits;
+            break;
+    }
+    *size *= (long)m->count;
+    return 1;
+} /* member_size */
+
+/*
+ * Fills in l (whose offsets array has room for every member) for
+ * aggregate a on target t.  Returns 0, with the unknown values set to
+ * UNKNOWN, if a type isn't described by the target's results.
+ */
+static int compute_layout(const struct aggregate *a, const struct target *t, struct layout *l) {
+    long offset = 0;
+    long used = 0;
+    long align = 1;
+    size_t i;
+
+    l->size = l->align = l->padding = UNKNOWN;
+    for (i = 0; i < a->member_count; i ++) {
+        l->offsets[i] = UNKNOWN;
+    }
+    for (i = 0; i < a->member_count; i ++) {
+        long size, member_align;
+        if (! member_size(&a->members[i], t, &size, &member_align)) {
+            return 0;
+        }
+        if (member_align > align) {
+            align = member_align;
+        }
+        if (a->is_union) {
+            l->offsets[i] = 0;
+            if (size > offset) {
+                offset = size;
+            }
+            if (size > used) {
+                used = size;
+            }
+        }
+        else {
+            offset = (offset + member_align - 1) / member_align * member_align;
+            l->offsets[i] = offset;
+            offset += size;
+            used += size;
+        }
+    }
+    l->align = align;
+    l->size = (offset + align - 1) / align * align;
+    l->padding = l->size - used;
+    return 1;
+} /* compute_layout */
+
+/*
+ * Output.
+ */
+
+static void show_legend(void) {
+    size_t i;
+    puts("Targets:");
+    for (i = 0; i < target_count; i ++) {
+        printf("    %2lu  %s\n", (unsigned long)(i + 1), targets[i].name);
+    }
+    putchar('\n');
+}
+
+/*
+ * Shows one row of a table, unless differing_only is set and the values
+ * are the same on every target.  Returns 1 if the row was shown.
+ */
+static int show_row(const char *label, const long *values, int differing_only) {
+    int differs = 0;
+    size_t i;
+    for (i = 1; i < target_count; i ++) {
+        differs |= values[i] != values[0];
+    }
+    if (differing_only && ! differs) {
+        return 0;
+    }
+    printf("    %-28s", label);
+    for (i = 0; i < target_count; i ++) {
+        if (values[i] == UNKNOWN) {
+            printf(" %5s", "?");
+        }
+        else {
+            printf(" %5ld", values[i]);
+        }
+    }
+    puts(differs ? "  *" : "");
+    return 1;
+}
+
+static void show_aggregate(const struct aggregate *a, int differing_only) {
+    struct layout *const layouts = xrealloc(NULL, target_count * sizeof *layouts);
+    long *const values = xrealloc(NULL, target_count * sizeof *values);
+    char title[2 * NAME_SIZE + 16];
+    size_t i, m;
+    int shown = 0;
+
+    for (i = 0; i < target_count; i ++) {
+        layouts[i].offsets = xrealloc(NULL, a->member_count * sizeof *layouts[i].offsets);
+        compute_layout(a, &targets[i], &layouts[i]);
+    }
+
+    sprintf(title, "%s %s", a->is_union ? "union" : "struct",
+            a->name[0] != '\0' ? a->name : a->typedef_name[0] != '\0' ? a->typedef_name : "(anonymous)");
+    printf("%-32s", title);
+    for (i = 0; i < target_count; i ++) {
+        printf(" %5lu", (unsigned long)(i + 1));
+    }
+    putchar('\n');
+
+    for (m = 0; m < a->member_count; m ++) {
+        char label[NAME_SIZE + 1];
+        sprintf(label, ".%s", a->members[m].name);
+        for (i = 0; i < target_count; i ++) {
+            values[i] = layouts[i].offsets[m];
+        }
+        shown += show_row(label, values, differing_only);
+    }
+    for (i = 0; i < target_count; i ++) {
+        values[i] = layouts[i].size;
+    }
+    shown += show_row("sizeof", values, differing_only);
+    for (i = 0; i < target_count; i ++) {
+        values[i] = layouts[i].align;
+    }
+    shown += show_row("alignment", values, differing_only);
+    for (i = 0; i < target_count; i ++) {
+        values[i] = layouts[i].padding;
+    }
+    shown += show_row("padding", values, differing_only);
+    if (! shown) {
+        puts("    (the same on all targets)");
+    }
+    putchar('\n');
+
+    for (i = 0; i < target_count; i ++) {
+        free(layouts[i].offsets);
+    }
+    free(layouts);
+    free(values);
+} /* show_aggregate */
+
+static void usage(const char *program_name) {
+    fprintf(stderr, "Usage: %s [-d directory] [-D] [file...]\n", program_name);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    const char *directory = DEFAULT_DIRECTORY;
+    int differing_only = 0;
+    size_t first_shown = 0;
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i ++) {
+        if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            directory = argv[++i];
+        }
+        else if (strcmp(argv[i], "-D") == 0) {
+            differing_only = 1;
+        }
+        else {
+            usage(argv[0]);
+        }
+    }
+    if (! load_results(directory)) {
+        exit(EXIT_FAILURE);
+    }
+
+    do {
+        const char *const name = i < argc ? argv[i] : "-";
+        FILE *const f = strcmp(name, "-") == 0 ? stdin : fopen(name, "r");
+        struct input in;
+        char *text;
+        if (f == NULL || (text = read_file(f)) == NULL) {
+            perror(name);
+            exit(EXIT_FAILURE);
+        }
+        if (f != stdin) {
+            fclose(f);
+        }
+        in.file_name = name;
+        tokenize(&in, text);
+        parse_input(&in);
+        free(in.tokens);
+        free(text);
+    } while (++i < argc);
+
+    show_legend();
+    for (; first_shown < aggregate_count; first_shown ++) {
+        show_aggregate(aggregates[first_shown], differing_only);
+    }
+    return 0;
+} /* main */